@@ -16,6 +16,7 @@
 
 #include <immintrin.h>
 #include "types/array/StaticArray.h"
+#include "types/test/UnitTest.h"
 #include <vector>
 
 #define print(message) std::cout << message << '\n'
@@ -43,6 +44,8 @@ struct Test {
 
 int main() {
 
+	UnitTest::RunRuntimeUnitTests();
+
 	sarray<int, 6> arr = { 1, 2, 5, 1, 6, 7, 12, 54 };
 
 }
\ No newline at end of file
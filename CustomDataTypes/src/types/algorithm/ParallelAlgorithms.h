@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <types/thread/ThreadPool.h>
+#include <types/array/DynamicArray.h>
+#include <types/array/StaticArray.h>
+
+/* Default amount of elements each thread works on at a time. Inputs no larger than this run serially on the calling thread. */
+#ifndef PARALLEL_GRAIN_SIZE
+#define PARALLEL_GRAIN_SIZE 16384
+#endif
+
+/*
+Parallel algorithms over contiguous elements, running on a ThreadPool (ThreadPool::Global() by default).
+Each algorithm has a pointer + count form, as well as darray and sarray overloads.
+grainSize is the amount of elements a thread claims at a time. Smaller values balance uneven work better,
+larger values have less scheduling overhead. Inputs no larger than grainSize run serially.
+*/
+
+namespace ParallelInternal
+{
+	/* Uninitialized storage for count elements. Elements constructed into it must be destroyed by the owner. */
+	template<typename T>
+	struct Buffer
+	{
+		T* data;
+		size_t count;
+
+		Buffer(size_t count) : data(std::allocator<T>().allocate(count)), count(count) {}
+		~Buffer() { std::allocator<T>().deallocate(data, count); }
+		Buffer(const Buffer&) = delete;
+		void operator = (const Buffer&) = delete;
+	};
+
+	/* Amount of elements taken from a for the first diagonal elements of a stable merge of a and b. */
+	template<typename T, typename Compare>
+	size_t MergeSplit(const T* a, size_t aCount, const T* b, size_t bCount, size_t diagonal, Compare& comp)
+	{
+		size_t low = diagonal > bCount ? diagonal - bCount : 0;
+		size_t high = diagonal < aCount ? diagonal : aCount;
+		while (low < high) {
+			const size_t mid = low + (high - low) / 2;
+			if (comp(b[diagonal - mid - 1], a[mid])) {
+				high = mid;
+			}
+			else {
+				low = mid + 1;
+			}
+		}
+		return low;
+	}
+
+	/* Stable merge of the sorted ranges a and b into out by moving, splitting the output into parts of roughly grainSize elements.
+	Every split is found before any part starts moving elements out of a and b. */
+	template<typename T, typename Compare>
+	void ParallelMerge(T* a, size_t aCount, T* b, size_t bCount, T* out, Compare& comp, size_t grainSize, ThreadPool& pool)
+	{
+		const size_t total = aCount + bCount;
+		const size_t parts = (total + grainSize - 1) / grainSize;
+		darray<size_t> splits;
+		splits.Reserve(parts + 1);
+		for (size_t i = 0; i <= parts; i++) {
+			splits.Add(0);
+		}
+
+		pool.ParallelFor(parts + 1, 1, [&](size_t begin, size_t end) {
+			for (size_t part = begin; part < end; part++) {
+				splits[part] = MergeSplit(a, aCount, b, bCount, part * total / parts, comp);
+			}
+		});
+
+		pool.ParallelFor(parts, 1, [&](size_t begin, size_t end) {
+			for (size_t part = begin; part < end; part++) {
+				const size_t outBegin = part * total / parts;
+				const size_t outEnd = (part + 1) * total / parts;
+				std::merge(
+					std::make_move_iterator(a + splits[part]), std::make_move_iterator(a + splits[part + 1]),
+					std::make_move_iterator(b + outBegin - splits[part]), std::make_move_iterator(b + outEnd - splits[part + 1]),
+					out + outBegin, comp);
+			}
+		});
+	}
+}
+
+/* Call func on every element.
+@param func: Callable taking T&. Is called concurrently, so it must be safe to call from multiple threads. */
+template<typename T, typename Func>
+void ParallelForEach(T* data, size_t count, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			func(data[i]);
+		}
+	});
+}
+
+/* Set every element of out to func(in[i]). out must hold at least count elements, and may be the same as in.
+@param func: Callable taking const T& and returning something assignable to U. */
+template<typename T, typename U, typename Func>
+void ParallelTransform(const T* in, size_t count, U* out, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			out[i] = func(in[i]);
+		}
+	});
+}
+
+/* Combine every element with op, starting from init. Elements are combined in order within each chunk, and chunks in order,
+so op must be associative but does not need to be commutative.
+@param op: Callable taking (const T&, const T&) and returning T. */
+template<typename T, typename BinaryOp = std::plus<>>
+T ParallelReduce(const T* data, size_t count, T init, BinaryOp op = BinaryOp(), size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+	if (count <= grainSize || pool.ThreadCount() == 1) {
+		for (size_t i = 0; i < count; i++) {
+			init = op(init, data[i]);
+		}
+		return init;
+	}
+
+	const size_t chunks = (count + grainSize - 1) / grainSize;
+	ParallelInternal::Buffer<T> partials(chunks);
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		T partial = data[begin];
+		for (size_t i = begin + 1; i < end; i++) {
+			partial = op(partial, data[i]);
+		}
+		new (partials.data + begin / grainSize) T(std::move(partial));
+	});
+
+	for (size_t i = 0; i < chunks; i++) {
+		init = op(init, partials.data[i]);
+	}
+	std::destroy(partials.data, partials.data + chunks);
+	return init;
+}
+
+/* Stable partition. Elements satisfying pred are moved to the front, keeping their relative order, followed by the rest in their relative order.
+@param pred: Callable taking const T& and returning bool. Is called twice per element, so it must always return the same result for the same element.
+@returns The amount of elements satisfying pred. */
+template<typename T, typename Pred>
+size_t ParallelPartition(T* data, size_t count, Pred&& pred, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+	if (count <= grainSize || pool.ThreadCount() == 1) {
+		return std::stable_partition(data, data + count, pred) - data;
+	}
+
+	const size_t chunks = (count + grainSize - 1) / grainSize;
+	darray<size_t> offsets;
+	offsets.Reserve(chunks);
+	for (size_t i = 0; i < chunks; i++) {
+		offsets.Add(0);
+	}
+
+	// Count the matching elements of each chunk, then turn the counts into each chunk's output offset.
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		size_t matches = 0;
+		for (size_t i = begin; i < end; i++) {
+			matches += pred(data[i]) ? 1 : 0;
+		}
+		offsets[begin / grainSize] = matches;
+	});
+
+	size_t totalMatches = 0;
+	for (size_t i = 0; i < chunks; i++) {
+		const size_t matches = offsets[i];
+		offsets[i] = totalMatches;
+		totalMatches += matches;
+	}
+
+	ParallelInternal::Buffer<T> buffer(count);
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		size_t matchOut = offsets[begin / grainSize];
+		size_t restOut = totalMatches + (begin - matchOut);
+		for (size_t i = begin; i < end; i++) {
+			if (pred(data[i])) {
+				new (buffer.data + matchOut++) T(std::move(data[i]));
+			}
+			else {
+				new (buffer.data + restOut++) T(std::move(data[i]));
+			}
+		}
+	});
+
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		std::move(buffer.data + begin, buffer.data + end, data + begin);
+		std::destroy(buffer.data + begin, buffer.data + end);
+	});
+	return totalMatches;
+}
+
+/* Stable merge sort. Runs are sorted in parallel, and then merged in parallel rounds. Uses a temporary buffer of count elements.
+@param comp: Strict weak ordering taking (const T&, const T&). */
+template<typename T, typename Compare = std::less<>>
+void ParallelSort(T* data, size_t count, Compare comp = Compare(), size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+	if (count <= grainSize || pool.ThreadCount() == 1) {
+		std::stable_sort(data, data + count, comp);
+		return;
+	}
+
+	// One run per thread, but never smaller than the grain size.
+	const size_t threads = pool.ThreadCount();
+	size_t runSize = (count + threads - 1) / threads;
+	runSize = runSize > grainSize ? runSize : grainSize;
+	const size_t runs = (count + runSize - 1) / runSize;
+	pool.ParallelFor(runs, 1, [&](size_t begin, size_t end) {
+		for (size_t run = begin; run < end; run++) {
+			T* first = data + run * runSize;
+			std::stable_sort(first, first + std::min(runSize, count - run * runSize), comp);
+		}
+	});
+
+	ParallelInternal::Buffer<T> buffer(count);
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		std::uninitialized_move(data + begin, data + end, buffer.data + begin);
+	});
+
+	// Merge pairs of runs back and forth between the buffer and data.
+	T* source = buffer.data;
+	T* dest = data;
+	for (size_t width = runSize; width < count; width *= 2) {
+		const size_t pairs = (count + 2 * width - 1) / (2 * width);
+		auto mergePair = [&](size_t pair, bool parallel) {
+			const size_t first = pair * 2 * width;
+			const size_t middle = std::min(first + width, count);
+			const size_t last = std::min(first + 2 * width, count);
+			if (parallel) {
+				ParallelInternal::ParallelMerge(source + first, middle - first, source + middle, last - middle, dest + first, comp, grainSize, pool);
+			}
+			else {
+				std::merge(
+					std::make_move_iterator(source + first), std::make_move_iterator(source + middle),
+					std::make_move_iterator(source + middle), std::make_move_iterator(source + last),
+					dest + first, comp);
+			}
+		};
+
+		if (pairs >= threads) {
+			pool.ParallelFor(pairs, 1, [&](size_t begin, size_t end) {
+				for (size_t pair = begin; pair < end; pair++) {
+					mergePair(pair, false);
+				}
+			});
+		}
+		else {
+			for (size_t pair = 0; pair < pairs; pair++) {
+				mergePair(pair, true);
+			}
+		}
+		std::swap(source, dest);
+	}
+
+	pool.ParallelFor(count, grainSize, [&](size_t begin, size_t end) {
+		if (source != data) {
+			std::move(source + begin, source + end, data + begin);
+		}
+		std::destroy(buffer.data + begin, buffer.data + end);
+	});
+}
+
+template<typename T, darray_cap_inc capacityInc, typename Allocator, typename Func>
+void ParallelForEach(darray<T, capacityInc, Allocator>& arr, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	ParallelForEach(arr.GetData(), arr.Size(), func, grainSize, pool);
+}
+
+template<typename T, size_t N, typename Func>
+void ParallelForEach(sarray<T, N>& arr, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	ParallelForEach(arr.GetData(), N, func, grainSize, pool);
+}
+
+/* Replace every element with func(element). */
+template<typename T, darray_cap_inc capacityInc, typename Allocator, typename Func>
+void ParallelTransform(darray<T, capacityInc, Allocator>& arr, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	ParallelTransform(arr.GetData(), arr.Size(), arr.GetData(), func, grainSize, pool);
+}
+
+/* Set out to func(element) of every element of in. out is grown with default constructed elements if it is smaller than in. */
+template<typename T, darray_cap_inc capacityInc, typename Allocator, typename U, darray_cap_inc outCapacityInc, typename OutAllocator, typename Func>
+void ParallelTransform(const darray<T, capacityInc, Allocator>& in, darray<U, outCapacityInc, OutAllocator>& out, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	out.Reserve(in.Size());
+	while (out.Size() < in.Size()) {
+		out.Add(U());
+	}
+	ParallelTransform(in.GetData(), in.Size(), out.GetData(), func, grainSize, pool);
+}
+
+/* Replace every element with func(element). */
+template<typename T, size_t N, typename Func>
+void ParallelTransform(sarray<T, N>& arr, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	ParallelTransform(arr.GetData(), N, arr.GetData(), func, grainSize, pool);
+}
+
+template<typename T, size_t N, typename U, typename Func>
+void ParallelTransform(const sarray<T, N>& in, sarray<U, N>& out, Func&& func, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	ParallelTransform(in.GetData(), N, out.GetData(), func, grainSize, pool);
+}
+
+template<typename T, darray_cap_inc capacityInc, typename Allocator, typename BinaryOp = std::plus<>>
+T ParallelReduce(const darray<T, capacityInc, Allocator>& arr, T init, BinaryOp op = BinaryOp(), size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	return ParallelReduce(arr.GetData(), arr.Size(), std::move(init), op, grainSize, pool);
+}
+
+template<typename T, size_t N, typename BinaryOp = std::plus<>>
+T ParallelReduce(const sarray<T, N>& arr, T init, BinaryOp op = BinaryOp(), size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	return ParallelReduce(arr.GetData(), N, std::move(init), op, grainSize, pool);
+}
+
+template<typename T, darray_cap_inc capacityInc, typename Allocator, typename Pred>
+size_t ParallelPartition(darray<T, capacityInc, Allocator>& arr, Pred&& pred, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	return ParallelPartition(arr.GetData(), arr.Size(), pred, grainSize, pool);
+}
+
+template<typename T, size_t N, typename Pred>
+size_t ParallelPartition(sarray<T, N>& arr, Pred&& pred, size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	return ParallelPartition(arr.GetData(), N, pred, grainSize, pool);
+}
+
+template<typename T, darray_cap_inc capacityInc, typename Allocator, typename Compare = std::less<>>
+void ParallelSort(darray<T, capacityInc, Allocator>& arr, Compare comp = Compare(), size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	ParallelSort(arr.GetData(), arr.Size(), comp, grainSize, pool);
+}
+
+template<typename T, size_t N, typename Compare = std::less<>>
+void ParallelSort(sarray<T, N>& arr, Compare comp = Compare(), size_t grainSize = PARALLEL_GRAIN_SIZE, ThreadPool& pool = ThreadPool::Global())
+{
+	ParallelSort(arr.GetData(), N, comp, grainSize, pool);
+}
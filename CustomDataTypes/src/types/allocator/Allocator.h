@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+
+/* Allows empty allocator members to occupy no space within a container.
+msvc ignores the standard attribute, and requires it's own. */
+#if defined(_MSC_VER)
+#define DARRAY_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define DARRAY_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+/*
+Default allocator policy for darray. Allocates from the global heap through std::allocator,
+so arrays using it remain usable at compile time.
+
+An allocator policy must provide:
+-- T* Allocate(size_t count) -- Returns uninitialized storage for count elements.
+-- void Free(T* block, size_t count) -- Frees storage previously returned by Allocate().
+
+And may optionally provide:
+-- bool TryResizeInPlace(T* block, size_t oldCount, size_t newCount) -- Grow or shrink a block without moving it. Returns false if not possible.
+-- bool IsInline(const T* block) -- Whether a block is stored within the allocator itself. Such blocks are never handed to another array.
+-- static constexpr size_t INITIAL_CAPACITY -- Capacity of newly constructed arrays.
+-- static constexpr bool USES_GLOBAL_HEAP -- Whether non inline blocks come from std::allocator<T>, so arrays with different allocators can take each other's blocks.
+
+@param - T: Type of the elements being allocated.
+*/
+template<typename T>
+struct darray_allocator
+{
+	static constexpr bool USES_GLOBAL_HEAP = true;
+
+	/* Get uninitialized storage for count elements. */
+	constexpr T* Allocate(size_t count)
+	{
+		return std::allocator<T>().allocate(count);
+	}
+
+	/* Free storage from Allocate(). Does not call any destructors. */
+	constexpr void Free(T* block, size_t count)
+	{
+		std::allocator<T>().deallocate(block, count);
+	}
+};
@@ -0,0 +1,105 @@
+#include "ArenaAllocator.h"
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+/* Round a value up to the next multiple of a power of 2 alignment. */
+static size_t AlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+ArenaAllocator::ArenaAllocator(size_t _blockSize)
+{
+	current = nullptr;
+	blockSize = _blockSize;
+	lastAllocation = nullptr;
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+	while (current) {
+		Block* previous = current->previous;
+		free(current);
+		current = previous;
+	}
+}
+
+void ArenaAllocator::NewBlock(size_t minBytes)
+{
+	const size_t capacity = minBytes > blockSize ? minBytes : blockSize;
+	Block* block = static_cast<Block*>(malloc(sizeof(Block) + capacity));
+	if (!block) {
+		throw std::bad_alloc();
+	}
+	block->previous = current;
+	block->capacity = capacity;
+	block->used = 0;
+	current = block;
+}
+
+void* ArenaAllocator::Allocate(size_t bytes, size_t alignment)
+{
+	if (current) {
+		const uintptr_t base = reinterpret_cast<uintptr_t>(BlockData(current));
+		const size_t start = AlignUp(base + current->used, alignment) - base;
+		if (start + bytes <= current->capacity) {
+			current->used = start + bytes;
+			lastAllocation = BlockData(current) + start;
+			return lastAllocation;
+		}
+	}
+
+	// Extra space to guarantee alignment larger than the block header's.
+	NewBlock(bytes + alignment);
+	const uintptr_t base = reinterpret_cast<uintptr_t>(BlockData(current));
+	const size_t start = AlignUp(base, alignment) - base;
+	current->used = start + bytes;
+	lastAllocation = BlockData(current) + start;
+	return lastAllocation;
+}
+
+void ArenaAllocator::Free(void* allocation, size_t /*bytes*/)
+{
+	if (allocation == nullptr || allocation != lastAllocation) {
+		return;
+	}
+	current->used = static_cast<char*>(allocation) - BlockData(current);
+	lastAllocation = nullptr;
+}
+
+bool ArenaAllocator::TryResize(void* allocation, size_t /*oldBytes*/, size_t newBytes)
+{
+	if (allocation == nullptr || allocation != lastAllocation) {
+		return false;
+	}
+	const size_t start = static_cast<char*>(allocation) - BlockData(current);
+	if (start + newBytes > current->capacity) {
+		return false;
+	}
+	current->used = start + newBytes;
+	return true;
+}
+
+void ArenaAllocator::Reset()
+{
+	if (current == nullptr) {
+		return;
+	}
+	while (current->previous) {
+		Block* previous = current->previous;
+		free(current);
+		current = previous;
+	}
+	current->used = 0;
+	lastAllocation = nullptr;
+}
+
+size_t ArenaAllocator::BytesUsed() const
+{
+	size_t total = 0;
+	for (Block* block = current; block; block = block->previous) {
+		total += block->used;
+	}
+	return total;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+Bump pointer arena. Allocations are carved sequentially out of large blocks, and are all freed at once
+by Reset() or destruction. Freeing an individual allocation is a no-op, unless it is the most recent one.
+Not thread safe. Use one arena per thread or per request.
+*/
+class ArenaAllocator
+{
+private:
+
+	/* Header placed at the start of each block. The block's usable memory follows directly after. */
+	struct Block
+	{
+		Block* previous;
+		size_t capacity;
+		size_t used;
+	};
+
+	/* Block currently being allocated from. */
+	Block* current;
+
+	/* The minimum usable size of newly created blocks. */
+	size_t blockSize;
+
+	/* Start of the most recent allocation, for in place resizing and freeing. */
+	void* lastAllocation;
+
+	/* Create a new block able to hold at least minBytes, and make it the current block. */
+	void NewBlock(size_t minBytes);
+
+	/* Get a pointer to the first usable byte of a block. */
+	static char* BlockData(Block* block) { return reinterpret_cast<char*>(block + 1); }
+
+public:
+
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	/* @param _blockSize: Minimum size in bytes of each block allocated from the heap. */
+	ArenaAllocator(size_t _blockSize = DEFAULT_BLOCK_SIZE);
+
+	/* Frees every block. Does not call destructors of anything allocated within. */
+	~ArenaAllocator();
+
+	ArenaAllocator(const ArenaAllocator&) = delete;
+	void operator = (const ArenaAllocator&) = delete;
+
+	/* Get a block of memory with the given alignment. Alignment must be a power of 2. */
+	void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+	/* Free an allocation. Only reclaims the memory if it was the most recent allocation. */
+	void Free(void* allocation, size_t bytes);
+
+	/* Try to resize the most recent allocation without moving it.
+	@returns If the allocation was resized. */
+	bool TryResize(void* allocation, size_t oldBytes, size_t newBytes);
+
+	/* Free every allocation at once. Keeps the first block for reuse. */
+	void Reset();
+
+	/* Total amount of bytes handed out since construction or the last Reset(). Includes alignment padding. */
+	size_t BytesUsed() const;
+};
+
+/* darray allocator policy that allocates from an ArenaAllocator.
+The arena must outlive every array using it. */
+template<typename T>
+struct darray_arena_allocator
+{
+	ArenaAllocator* arena;
+
+	constexpr darray_arena_allocator(ArenaAllocator* _arena) : arena(_arena) {}
+
+	/* Get uninitialized storage for count elements from the arena. */
+	T* Allocate(size_t count)
+	{
+		return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	/* Return storage to the arena. Only reclaimed if it is the arena's most recent allocation. */
+	void Free(T* block, size_t count)
+	{
+		arena->Free(block, count * sizeof(T));
+	}
+
+	/* Arrays that were the arena's last allocation grow without copying. */
+	bool TryResizeInPlace(T* block, size_t oldCount, size_t newCount)
+	{
+		return arena->TryResize(block, oldCount * sizeof(T), newCount * sizeof(T));
+	}
+};
@@ -0,0 +1,127 @@
+#include "HugePageAllocator.h"
+#include <new>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cstdlib>
+#endif
+
+#if defined(__linux__)
+
+/* Size of a transparent huge page on x86-64 and most arm64 configurations. */
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/* Mappings are made in whole huge pages, so the size passed to munmap and mremap is always consistent. */
+static size_t RoundToHugePages(size_t bytes)
+{
+	return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+void* HugePages::Allocate(size_t bytes)
+{
+	const size_t length = RoundToHugePages(bytes);
+
+	// Over map by a huge page, then trim, so the block starts on a huge page boundary.
+	void* mapping = mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapping == MAP_FAILED) {
+		throw std::bad_alloc();
+	}
+
+	char* start = static_cast<char*>(mapping);
+	char* aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(start) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+	if (aligned != start) {
+		munmap(start, aligned - start);
+	}
+	const size_t tail = (start + length + HUGE_PAGE_SIZE) - (aligned + length);
+	if (tail > 0) {
+		munmap(aligned + length, tail);
+	}
+
+	madvise(aligned, length, MADV_HUGEPAGE);
+	return aligned;
+}
+
+void HugePages::Free(void* block, size_t bytes)
+{
+	if (block) {
+		munmap(block, RoundToHugePages(bytes));
+	}
+}
+
+void* HugePages::Reallocate(void* block, size_t oldBytes, size_t newBytes)
+{
+	const size_t oldLength = RoundToHugePages(oldBytes);
+	const size_t newLength = RoundToHugePages(newBytes);
+	if (oldLength == newLength) {
+		return block;
+	}
+
+	void* moved = mremap(block, oldLength, newLength, MREMAP_MAYMOVE);
+	if (moved == MAP_FAILED) {
+		throw std::bad_alloc();
+	}
+	madvise(moved, newLength, MADV_HUGEPAGE);
+	return moved;
+}
+
+#elif defined(_WIN32)
+
+void* HugePages::Allocate(size_t bytes)
+{
+	const size_t largePageSize = GetLargePageMinimum();
+	if (largePageSize > 0) {
+		const size_t length = (bytes + largePageSize - 1) & ~(largePageSize - 1);
+		void* block = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (block) {
+			return block;
+		}
+	}
+
+	// Large pages require the lock pages in memory privilege, fall back to regular pages.
+	void* block = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (!block) {
+		throw std::bad_alloc();
+	}
+	return block;
+}
+
+void HugePages::Free(void* block, size_t /*bytes*/)
+{
+	if (block) {
+		VirtualFree(block, 0, MEM_RELEASE);
+	}
+}
+
+void* HugePages::Reallocate(void* /*block*/, size_t /*oldBytes*/, size_t /*newBytes*/)
+{
+	return nullptr;
+}
+
+#else
+
+void* HugePages::Allocate(size_t bytes)
+{
+	void* block = malloc(bytes);
+	if (!block) {
+		throw std::bad_alloc();
+	}
+	return block;
+}
+
+void HugePages::Free(void* block, size_t /*bytes*/)
+{
+	free(block);
+}
+
+void* HugePages::Reallocate(void* /*block*/, size_t /*oldBytes*/, size_t /*newBytes*/)
+{
+	return nullptr;
+}
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+/* Allocations of at least this many bytes are mapped directly from the OS, backed by huge pages where possible.
+Optionally override by doing -- #define HUGE_PAGE_ALLOCATION_THRESHOLD <bytes> -- before including this header. */
+#ifndef HUGE_PAGE_ALLOCATION_THRESHOLD
+#define HUGE_PAGE_ALLOCATION_THRESHOLD (4ULL * 1024 * 1024)
+#endif
+
+/* Page mappings directly from the OS, for very large allocations.
+On Linux, mappings are aligned to, and advised (MADV_HUGEPAGE) to use, transparent huge pages, and can be grown with mremap.
+On Windows, large pages are used if the process has the privilege to lock memory, otherwise regular pages are. */
+namespace HugePages
+{
+	/* Map at least the specified amount of bytes. Never returns nullptr, throws std::bad_alloc on failure. */
+	void* Allocate(size_t bytes);
+
+	/* Unmap a block from Allocate(). Bytes must be the same value passed when allocating or reallocating. */
+	void Free(void* block, size_t bytes);
+
+	/* Grow or shrink a mapping, moving it's pages rather than copying if it needs to move.
+	@returns The new address of the block, or nullptr if not supported by the OS, in which case the block is unchanged. */
+	void* Reallocate(void* block, size_t oldBytes, size_t newBytes);
+}
+
+/* darray allocator policy that maps arrays of at least HUGE_PAGE_ALLOCATION_THRESHOLD bytes through HugePages,
+reducing TLB misses and allowing trivially relocatable arrays to grow without copying.
+Smaller arrays are allocated from the global heap. */
+template<typename T>
+struct darray_huge_page_allocator
+{
+	/* Whether an allocation of count elements is mapped through HugePages. */
+	static bool IsMapped(size_t count)
+	{
+		return count * sizeof(T) >= HUGE_PAGE_ALLOCATION_THRESHOLD;
+	}
+
+	/* Get uninitialized storage for count elements. */
+	T* Allocate(size_t count)
+	{
+		if (IsMapped(count)) {
+			return static_cast<T*>(HugePages::Allocate(count * sizeof(T)));
+		}
+		return std::allocator<T>().allocate(count);
+	}
+
+	/* Free storage from Allocate(). Does not call any destructors. */
+	void Free(T* block, size_t count)
+	{
+		if (IsMapped(count)) {
+			HugePages::Free(block, count * sizeof(T));
+		}
+		else {
+			std::allocator<T>().deallocate(block, count);
+		}
+	}
+
+	/* Move a mapped block to a new size without copying. Only used by darray for trivially relocatable types.
+	@returns The new block, or nullptr if either size is below the threshold or the OS does not support remapping. */
+	T* ReallocateTrivial(T* block, size_t oldCount, size_t newCount)
+	{
+		if (!IsMapped(oldCount) || !IsMapped(newCount)) {
+			return nullptr;
+		}
+		return static_cast<T*>(HugePages::Reallocate(block, oldCount * sizeof(T), newCount * sizeof(T)));
+	}
+};
@@ -0,0 +1,61 @@
+#include "PoolAllocator.h"
+#include <cstdlib>
+
+PoolAllocator::PoolAllocator(size_t _blockSize, size_t _blocksPerChunk)
+{
+	if (_blockSize < sizeof(FreeBlock)) {
+		_blockSize = sizeof(FreeBlock);
+	}
+	blockSize = (_blockSize + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+	blocksPerChunk = _blocksPerChunk > 0 ? _blocksPerChunk : 1;
+	freeList = nullptr;
+	chunks = nullptr;
+}
+
+PoolAllocator::~PoolAllocator()
+{
+	while (chunks) {
+		Chunk* previous = chunks->previous;
+		free(chunks);
+		chunks = previous;
+	}
+}
+
+void PoolAllocator::NewChunk()
+{
+	// The chunk header is padded to keep every block aligned.
+	const size_t headerSize = (sizeof(Chunk) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+	Chunk* chunk = static_cast<Chunk*>(malloc(headerSize + blockSize * blocksPerChunk));
+	if (!chunk) {
+		throw std::bad_alloc();
+	}
+	chunk->previous = chunks;
+	chunks = chunk;
+
+	char* blocks = reinterpret_cast<char*>(chunk) + headerSize;
+	for (size_t i = blocksPerChunk; i > 0; i--) {
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(blocks + (i - 1) * blockSize);
+		block->next = freeList;
+		freeList = block;
+	}
+}
+
+void* PoolAllocator::Allocate()
+{
+	if (freeList == nullptr) {
+		NewChunk();
+	}
+	FreeBlock* block = freeList;
+	freeList = block->next;
+	return block;
+}
+
+void PoolAllocator::Free(void* block)
+{
+	if (block == nullptr) {
+		return;
+	}
+	FreeBlock* freed = static_cast<FreeBlock*>(block);
+	freed->next = freeList;
+	freeList = freed;
+}
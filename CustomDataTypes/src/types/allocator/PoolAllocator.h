@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+/*
+Fixed size block pool. Every allocation is the same size, and is served from an intrusive free list,
+making allocating and freeing O(1) with no heap traffic once warmed up.
+Blocks are carved from larger chunks, which are only returned to the heap on destruction.
+Not thread safe.
+*/
+class PoolAllocator
+{
+private:
+
+	/* Free blocks store the pointer to the next free block within themselves. */
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	/* Chunks are linked through a header at their start. */
+	struct Chunk
+	{
+		Chunk* previous;
+	};
+
+	FreeBlock* freeList;
+
+	Chunk* chunks;
+
+	/* Size in bytes of each block. */
+	size_t blockSize;
+
+	/* Amount of blocks created per chunk. */
+	size_t blocksPerChunk;
+
+	/* Allocate a new chunk and push all of it's blocks onto the free list. */
+	void NewChunk();
+
+public:
+
+	/* Alignment of every block. */
+	static constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+	/* @param _blockSize: Size in bytes of every block. Rounded up to a multiple of BLOCK_ALIGNMENT.
+	@param _blocksPerChunk: Amount of blocks allocated from the heap at a time. */
+	PoolAllocator(size_t _blockSize, size_t _blocksPerChunk = 64);
+
+	/* Frees every chunk. Does not call destructors of anything allocated within. */
+	~PoolAllocator();
+
+	PoolAllocator(const PoolAllocator&) = delete;
+	void operator = (const PoolAllocator&) = delete;
+
+	/* Get a single block. */
+	void* Allocate();
+
+	/* Return a block to the pool. */
+	void Free(void* block);
+
+	/* Size in bytes of each block. */
+	size_t BlockSize() const { return blockSize; }
+};
+
+/* darray allocator policy that serves arrays small enough to fit in a single block from a PoolAllocator.
+Larger arrays fall back to the global heap. The pool must outlive every array using it. */
+template<typename T>
+struct darray_pool_allocator
+{
+	PoolAllocator* pool;
+
+	constexpr darray_pool_allocator(PoolAllocator* _pool) : pool(_pool) {}
+
+	/* Whether an allocation of count elements is served by the pool. */
+	bool FitsInBlock(size_t count) const
+	{
+		return count * sizeof(T) <= pool->BlockSize() && alignof(T) <= PoolAllocator::BLOCK_ALIGNMENT;
+	}
+
+	/* Get uninitialized storage for count elements. */
+	T* Allocate(size_t count)
+	{
+		if (FitsInBlock(count)) {
+			return static_cast<T*>(pool->Allocate());
+		}
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+	}
+
+	/* Return storage to the pool, or the heap if it was too large for a block. */
+	void Free(T* block, size_t count)
+	{
+		if (FitsInBlock(count)) {
+			pool->Free(block);
+		}
+		else {
+			::operator delete(block, std::align_val_t(alignof(T)));
+		}
+	}
+
+	/* Arrays that stay within a single block never need to move. */
+	bool TryResizeInPlace(T* /*block*/, size_t oldCount, size_t newCount)
+	{
+		return FitsInBlock(oldCount) && FitsInBlock(newCount);
+	}
+};
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/* Pick the widest instruction set the compiler is targeting. msvc only defines __AVX2__ (with /arch:AVX2),
+and always supports SSE2 when targeting x64. */
+#if defined(__AVX2__)
+#define ARRAY_SEARCH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARRAY_SEARCH_SSE2
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#endif
+
+#if defined(ARRAY_SEARCH_AVX2) || defined(ARRAY_SEARCH_SSE2)
+#define ARRAY_SEARCH_VECTORIZED
+#endif
+
+/*
+Linear search kernels over contiguous elements, comparing a full vector register of elements per instruction.
+Works for integer, enum, pointer, float and double element types. Falls back to scalar loops
+when no supported instruction set is available.
+Float comparisons follow operator == semantics (NaN never matches, 0.0 matches -0.0).
+*/
+namespace ArraySearch
+{
+	/* Whether the search kernels support a type. */
+	template<typename T>
+	constexpr bool IsVectorizable =
+		(std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T> || std::is_floating_point_v<T>)
+		&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+	namespace Internal
+	{
+#if defined(ARRAY_SEARCH_AVX2)
+
+		typedef __m256i Vec;
+
+		constexpr size_t VECTOR_BYTES = 32;
+
+		inline Vec Load(const void* address) { return _mm256_loadu_si256(static_cast<const __m256i*>(address)); }
+
+		template<typename T>
+		inline Vec Broadcast(const T& value)
+		{
+			if constexpr (sizeof(T) == 1) { char v; memcpy(&v, &value, 1); return _mm256_set1_epi8(v); }
+			else if constexpr (sizeof(T) == 2) { short v; memcpy(&v, &value, 2); return _mm256_set1_epi16(v); }
+			else if constexpr (sizeof(T) == 4) { int v; memcpy(&v, &value, 4); return _mm256_set1_epi32(v); }
+			else { long long v; memcpy(&v, &value, 8); return _mm256_set1_epi64x(v); }
+		}
+
+		/* Byte mask with every byte of each matching element set. */
+		template<typename T>
+		inline uint32_t CompareBytes(Vec block, Vec needle)
+		{
+			if constexpr (std::is_same_v<T, float>) {
+				return (uint32_t)_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ)));
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				return (uint32_t)_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ)));
+			}
+			else if constexpr (sizeof(T) == 1) { return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)); }
+			else if constexpr (sizeof(T) == 2) { return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi16(block, needle)); }
+			else if constexpr (sizeof(T) == 4) { return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi32(block, needle)); }
+			else { return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi64(block, needle)); }
+		}
+
+#elif defined(ARRAY_SEARCH_SSE2)
+
+		typedef __m128i Vec;
+
+		constexpr size_t VECTOR_BYTES = 16;
+
+		inline Vec Load(const void* address) { return _mm_loadu_si128(static_cast<const __m128i*>(address)); }
+
+		template<typename T>
+		inline Vec Broadcast(const T& value)
+		{
+			if constexpr (sizeof(T) == 1) { char v; memcpy(&v, &value, 1); return _mm_set1_epi8(v); }
+			else if constexpr (sizeof(T) == 2) { short v; memcpy(&v, &value, 2); return _mm_set1_epi16(v); }
+			else if constexpr (sizeof(T) == 4) { int v; memcpy(&v, &value, 4); return _mm_set1_epi32(v); }
+			else { long long v; memcpy(&v, &value, 8); return _mm_set1_epi64x(v); }
+		}
+
+		/* Byte mask with every byte of each matching element set. */
+		template<typename T>
+		inline uint32_t CompareBytes(Vec block, Vec needle)
+		{
+			if constexpr (std::is_same_v<T, float>) {
+				return (uint32_t)_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle))));
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				return (uint32_t)_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle))));
+			}
+			else if constexpr (sizeof(T) == 1) { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)); }
+			else if constexpr (sizeof(T) == 2) { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(block, needle)); }
+			else if constexpr (sizeof(T) == 4) { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle)); }
+			else {
+#if defined(__SSE4_1__)
+				return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi64(block, needle));
+#else
+				// Both 32 bit halves must match.
+				const __m128i halves = _mm_cmpeq_epi32(block, needle);
+				return (uint32_t)_mm_movemask_epi8(_mm_and_si128(halves, _mm_shuffle_epi32(halves, 0b10110001)));
+#endif
+			}
+		}
+
+#endif
+
+#ifdef ARRAY_SEARCH_VECTORIZED
+
+		/* Amount of elements compared per vector. */
+		template<typename T>
+		constexpr size_t VECTOR_ELEMENTS = VECTOR_BYTES / sizeof(T);
+
+		/* Bits kept from a byte mask so each element is represented by a single bit (it's lowest byte). */
+		template<typename T>
+		constexpr uint32_t ELEMENT_BITS =
+			sizeof(T) == 1 ? 0xFFFFFFFF :
+			sizeof(T) == 2 ? 0x55555555 :
+			sizeof(T) == 4 ? 0x11111111 : 0x01010101;
+
+		/* Mask with a single bit per matching element in a vector of elements. Bit position / sizeof(T) is the element offset. */
+		template<typename T>
+		inline uint32_t MatchMask(const T* block, Vec needle)
+		{
+			return CompareBytes<T>(Load(block), needle) & ELEMENT_BITS<T>;
+		}
+
+#endif
+	}
+
+	/* Find the index of the nth occurrence of a value.
+	@param occurrence: nth occurrence of the value (value of 1 = first).
+	@returns Index of the found element, or count if not found. */
+	template<typename T>
+	size_t FindFirst(const T* data, size_t count, const T& value, size_t occurrence = 1)
+	{
+		static_assert(IsVectorizable<T>, "ArraySearch::FindFirst() element type is not supported");
+		if (occurrence == 0) {
+			return count;
+		}
+
+		size_t i = 0;
+#ifdef ARRAY_SEARCH_VECTORIZED
+		using namespace Internal;
+		const Vec needle = Broadcast(value);
+		for (; i + VECTOR_ELEMENTS<T> <= count; i += VECTOR_ELEMENTS<T>) {
+			uint32_t mask = MatchMask(data + i, needle);
+			const size_t matches = std::popcount(mask);
+			if (matches < occurrence) {
+				occurrence -= matches;
+				continue;
+			}
+			while (--occurrence > 0) {
+				mask &= mask - 1;
+			}
+			return i + std::countr_zero(mask) / sizeof(T);
+		}
+#endif
+		for (; i < count; i++) {
+			if (data[i] == value && --occurrence == 0) {
+				return i;
+			}
+		}
+		return count;
+	}
+
+	/* Find the index of the last occurrence of a value.
+	@returns Index of the found element, or count if not found. */
+	template<typename T>
+	size_t FindLast(const T* data, size_t count, const T& value)
+	{
+		static_assert(IsVectorizable<T>, "ArraySearch::FindLast() element type is not supported");
+		size_t i = count;
+#ifdef ARRAY_SEARCH_VECTORIZED
+		using namespace Internal;
+		const Vec needle = Broadcast(value);
+		while (i >= VECTOR_ELEMENTS<T>) {
+			i -= VECTOR_ELEMENTS<T>;
+			const uint32_t mask = MatchMask(data + i, needle);
+			if (mask) {
+				return i + (31 - std::countl_zero(mask)) / sizeof(T);
+			}
+		}
+#endif
+		while (i > 0) {
+			i--;
+			if (data[i] == value) {
+				return i;
+			}
+		}
+		return count;
+	}
+
+	/* Count the amount of elements equal to a value. */
+	template<typename T>
+	size_t Count(const T* data, size_t count, const T& value)
+	{
+		static_assert(IsVectorizable<T>, "ArraySearch::Count() element type is not supported");
+		size_t total = 0;
+		size_t i = 0;
+#ifdef ARRAY_SEARCH_VECTORIZED
+		using namespace Internal;
+		const Vec needle = Broadcast(value);
+		for (; i + VECTOR_ELEMENTS<T> <= count; i += VECTOR_ELEMENTS<T>) {
+			total += std::popcount(MatchMask(data + i, needle));
+		}
+#endif
+		for (; i < count; i++) {
+			total += data[i] == value;
+		}
+		return total;
+	}
+
+	/* Call a function with the index of every element equal to a value, in ascending order.
+	@param func: Callable taking a size_t index. */
+	template<typename T, typename Func>
+	void ForEachMatch(const T* data, size_t count, const T& value, Func&& func)
+	{
+		static_assert(IsVectorizable<T>, "ArraySearch::ForEachMatch() element type is not supported");
+		size_t i = 0;
+#ifdef ARRAY_SEARCH_VECTORIZED
+		using namespace Internal;
+		const Vec needle = Broadcast(value);
+		for (; i + VECTOR_ELEMENTS<T> <= count; i += VECTOR_ELEMENTS<T>) {
+			uint32_t mask = MatchMask(data + i, needle);
+			while (mask) {
+				func(i + std::countr_zero(mask) / sizeof(T));
+				mask &= mask - 1;
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			if (data[i] == value) {
+				func(i);
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#include "ChunkedArray.h"
+#include <types/test/UnitTest.h>
+
+#ifdef RUN_UNIT_TESTS_AT_COMPILE
+namespace ChunkedArrayCompileUnitTests
+{
+	/* Using a chunked array as a queue in either direction recycles emptied chunks instead of growing the chunk array. */
+	constexpr bool ChunkedArrayQueueBounded()
+	{
+		chunked_darray<int, 4> arr;
+		for (int i = 0; i < 1000; i++) {
+			arr.Add(i);
+			arr.Add(i);
+			int removed = -1;
+			arr.RemoveFront(&removed);
+			if (removed != i / 2 || arr.Size() != ArrInt(i + 1)) return false;
+		}
+		for (int i = 0; i < 1000; i++) {
+			arr.RemoveFront();
+			arr.Add(i);
+		}
+		if (arr.ChunkCount() > 2 * (arr.Size() / 4 + 2) || arr[0] != 0 || arr[999] != 999) return false;
+
+		chunked_darray<int, 4> front;
+		for (int i = 0; i < 1000; i++) {
+			front.AddFront(i);
+			int removed = -1;
+			front.RemoveBack(&removed);
+			if (removed != i || front.Size() != 0) return false;
+			front.AddFront(i);
+			front.AddFront(i);
+			front.RemoveBack();
+			front.RemoveBack();
+		}
+		if (front.ChunkCount() > 4) return false;
+
+		front.Clear();
+		front.Add(1);
+		front.AddFront(0);
+		return front.Size() == 2 && front[0] == 0 && front[1] == 1;
+	}
+	TEST_ASSERT(ChunkedArrayQueueBounded());
+}
+#endif
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <types/array/DynamicArray.h>
+
+/* Default amount of elements per chunk of a chunked_darray. Chunks are about 4KB, but hold at least 8 elements. */
+template<typename T>
+constexpr size_t CHUNKED_DARRAY_DEFAULT_CHUNK_SIZE = sizeof(T) * 8 < 4096 ? 4096 / sizeof(T) : 8;
+
+/*
+Double ended array of fixed size chunks. Adding to either end never moves any existing element, so pointers and references
+to elements stay valid until they are removed, and large elements are never copied when the array grows.
+Only the array of chunk pointers is reallocated as the array grows.
+Optionally disable out of bounds checks for indexing by setting the ARRAY_CHECK_OUT_OF_BOUNDS macro to false. See darray.
+
+@param - T: Type the array contains
+@param - ChunkSize (optional. default about 4KB worth of elements): Amount of elements stored in each chunk.
+*/
+template<typename T, size_t ChunkSize = CHUNKED_DARRAY_DEFAULT_CHUNK_SIZE<T>>
+struct chunked_darray
+{
+	static_assert(ChunkSize > 0, "chunked_darray must have a chunk size greater than 0");
+
+private:
+
+	/* Pointers to each chunk. Chunks outside of the ones holding elements may be nullptr, or kept allocated for reuse.
+	Emptied chunks at either end are recycled to the other end, so the amount of chunks stays proportional to the most elements held at once. */
+	darray<T*> chunks;
+
+	/* Slot of the first element, counting every slot of every chunk from the start of the chunks array. */
+	ArrInt first;
+
+	/* The amount of elements currently stored. */
+	ArrInt size;
+
+	/* Display an error message and abort the program. */
+	void ArrayError(const char* errorMessage) const
+	{
+		_ArrayError(errorMessage);
+		abort();
+	}
+
+	/* Get the element stored at a slot. The slot's chunk must be allocated. */
+	constexpr T* Slot(ArrInt slot) const
+	{
+		return chunks.GetData()[slot / ChunkSize] + slot % ChunkSize;
+	}
+
+	/* Make sure the chunk containing a slot is allocated. */
+	constexpr void EnsureChunk(ArrInt slot)
+	{
+		const ArrInt chunk = ArrInt(slot / ChunkSize);
+		while (chunks.Size() <= chunk) {
+			chunks.Add(nullptr);
+		}
+		if (chunks[chunk] == nullptr) {
+			chunks[chunk] = std::allocator<T>().allocate(ChunkSize);
+		}
+	}
+
+	/* Move the chunk pointers before the first element's chunk to the back, where Add() reuses them, and rebase first to the first chunk. */
+	constexpr void RecycleFrontChunks()
+	{
+		const ArrInt firstChunk = ArrInt(first / ChunkSize);
+		std::rotate(chunks.GetData(), chunks.GetData() + firstChunk, chunks.GetData() + chunks.Size());
+		first -= ArrInt(firstChunk * ChunkSize);
+	}
+
+	/* Make room for chunks before the first one. Moves chunk pointers only, never elements.
+	Recycles the chunks after the last element if at least half the chunk array is past it, otherwise doubles the chunk array. */
+	constexpr void GrowFront()
+	{
+		const ArrInt endChunk = ArrInt((first + size + ChunkSize - 1) / ChunkSize);
+		const ArrInt spareChunks = chunks.Size() - endChunk;
+		if (spareChunks > 0 && spareChunks * 2 >= chunks.Size()) {
+			std::rotate(chunks.GetData(), chunks.GetData() + endChunk, chunks.GetData() + chunks.Size());
+			first += ArrInt(spareChunks * ChunkSize);
+			return;
+		}
+
+		const ArrInt extraChunks = chunks.Size() > 0 ? chunks.Size() : 1;
+		if (extraChunks > (ARRAY_MAX_CAPACITY - first) / ChunkSize) {
+			ArrayError("Array capacity overflow from chunked_darray::AddFront(). Too many elements for the array size type.");
+		}
+
+		darray<T*> newChunks;
+		newChunks.Reserve(chunks.Size() + extraChunks);
+		for (ArrInt i = 0; i < extraChunks; i++) {
+			newChunks.Add(nullptr);
+		}
+		newChunks.InsertElements(chunks.GetData(), chunks.Size());
+		chunks = std::move(newChunks);
+		first += ArrInt(extraChunks * ChunkSize);
+	}
+
+	/* Destroy every element, keeping the chunks. */
+	constexpr void DestroyElements()
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			ForEach([](T& element) { std::destroy_at(&element); });
+		}
+	}
+
+	/* Free every chunk. Does not call any destructors. */
+	constexpr void FreeChunks()
+	{
+		for (ArrInt i = 0; i < chunks.Size(); i++) {
+			if (chunks[i]) {
+				std::allocator<T>().deallocate(chunks[i], ChunkSize);
+			}
+		}
+	}
+
+public:
+
+	/* Array custom iterator. */
+	class iterator
+	{
+	public:
+
+		constexpr iterator(const chunked_darray* _arr, ArrInt _index) : arr(_arr), index(_index) {}
+
+		constexpr iterator operator++() { ++index; return *this; }
+
+		constexpr bool operator!=(const iterator& other) const { return index != other.index; }
+
+		constexpr T& operator*() const { return *arr->Slot(arr->first + index); }
+
+	private:
+
+		const chunked_darray* arr;
+		ArrInt index;
+	};
+
+	/* Default constructor. Does not allocate until the first element is added. */
+	constexpr chunked_darray()
+	{
+		first = 0;
+		size = 0;
+	}
+
+	/* Copy constructor. Copies every element into newly allocated chunks. */
+	constexpr chunked_darray(const chunked_darray& other)
+	{
+		first = 0;
+		size = 0;
+		other.ForEach([this](const T& element) { Add(element); });
+	}
+
+	/* Move constructor. Takes the other array's chunks without moving any element. The other array is left empty. */
+	constexpr chunked_darray(chunked_darray&& other) noexcept
+		: chunks(std::move(other.chunks))
+	{
+		first = other.first;
+		size = other.size;
+		other.first = 0;
+		other.size = 0;
+	}
+
+	/* Destructor. Calls the destructors of all the stored elements, then frees every chunk. */
+	constexpr ~chunked_darray()
+	{
+		DestroyElements();
+		FreeChunks();
+	}
+
+	/* Copy assignment. Reuses this array's chunks. */
+	constexpr void operator = (const chunked_darray& other)
+	{
+		if (this == &other) {
+			return;
+		}
+		Clear();
+		other.ForEach([this](const T& element) { Add(element); });
+	}
+
+	/* Move assignment. Frees this array, and takes the other array's chunks without moving any element. */
+	constexpr void operator = (chunked_darray&& other) noexcept
+	{
+		if (this == &other) {
+			return;
+		}
+		DestroyElements();
+		FreeChunks();
+		chunks = std::move(other.chunks);
+		first = other.first;
+		size = other.size;
+		other.first = 0;
+		other.size = 0;
+	}
+
+	constexpr iterator begin() const { return iterator(this, 0); }
+	constexpr iterator end() const { return iterator(this, size); }
+
+	/* Get size of array. */
+	constexpr ArrInt Size() const { return size; }
+
+	/* Get the amount of chunk pointers, including unallocated ones. */
+	constexpr ArrInt ChunkCount() const { return chunks.Size(); }
+
+	/* Get a reference to an element at a specific index. Will only check if correct index if ARRAY_CHECK_OUT_OF_BOUNDS macro is set.
+	@param index: Array index to check.
+	@returns Reference to the item in the array. */
+	constexpr T& At(ArrInt index) const
+	{
+		#if ARRAY_CHECK_OUT_OF_BOUNDS == true
+		if (index >= size) {
+			ArrayError("Index out of bounds from chunked_darray::At().");
+		}
+		#endif
+		return *Slot(first + index);
+	}
+
+	/* Index of operator. See At(). */
+	constexpr T& operator [] (ArrInt index) const
+	{
+		return At(index);
+	}
+
+	/* Add element to the end of the array by const ref. Never moves existing elements. */
+	constexpr void Add(const T& value)
+	{
+		Emplace(value);
+	}
+
+	/* Add element to the end of the array by r value reference. Never moves existing elements. */
+	constexpr void Add(T&& value)
+	{
+		Emplace(std::move(value));
+	}
+
+	/* Construct an element at the end of the array from constructor arguments. Never moves existing elements.
+	@returns Reference to the new element. */
+	template<typename... Args>
+	constexpr T& Emplace(Args&&... args)
+	{
+		if (size > ARRAY_MAX_CAPACITY - first - 1) {
+			ArrayError("Array capacity overflow from chunked_darray::Add(). Too many elements for the array size type.");
+		}
+		const ArrInt slot = first + size;
+		EnsureChunk(slot);
+		T* element = std::construct_at(Slot(slot), std::forward<Args>(args)...);
+		size++;
+		return *element;
+	}
+
+	/* Add element to the start of the array by const ref. Never moves existing elements, but shifts every index up by 1. */
+	constexpr void AddFront(const T& value)
+	{
+		EmplaceFront(value);
+	}
+
+	/* Add element to the start of the array by r value reference. Never moves existing elements, but shifts every index up by 1. */
+	constexpr void AddFront(T&& value)
+	{
+		EmplaceFront(std::move(value));
+	}
+
+	/* Construct an element at the start of the array from constructor arguments. Never moves existing elements.
+	@returns Reference to the new element. */
+	template<typename... Args>
+	constexpr T& EmplaceFront(Args&&... args)
+	{
+		if (first == 0) {
+			GrowFront();
+		}
+		const ArrInt slot = first - 1;
+		EnsureChunk(slot);
+		T* element = std::construct_at(Slot(slot), std::forward<Args>(args)...);
+		first = slot;
+		size++;
+		return *element;
+	}
+
+	/* Remove the last element.
+	@param outElement (optional): Pointer to element type to move the removed element to. */
+	constexpr void RemoveBack(T* outElement = nullptr)
+	{
+		if (size == 0) {
+			return;
+		}
+		T* element = Slot(first + size - 1);
+		if (outElement) {
+			*outElement = std::move(*element);
+		}
+		std::destroy_at(element);
+		size--;
+	}
+
+	/* Remove the first element.
+	@param outElement (optional): Pointer to element type to move the removed element to. */
+	constexpr void RemoveFront(T* outElement = nullptr)
+	{
+		if (size == 0) {
+			return;
+		}
+		T* element = Slot(first);
+		if (outElement) {
+			*outElement = std::move(*element);
+		}
+		std::destroy_at(element);
+		first++;
+		size--;
+		// Once at least half the chunk array is before the elements, recycle the emptied chunks so a queue never grows the chunk array.
+		if (first % ChunkSize == 0 && first / ChunkSize * 2 >= chunks.Size()) {
+			RecycleFrontChunks();
+		}
+	}
+
+	/* Remove every element, keeping the chunks for reuse. */
+	constexpr void Clear()
+	{
+		DestroyElements();
+		first = 0;
+		size = 0;
+	}
+
+	/* Free every chunk that doesn't hold any elements. */
+	constexpr void Shrink()
+	{
+		const ArrInt firstChunk = ArrInt(first / ChunkSize);
+		const ArrInt endChunk = size > 0 ? ArrInt((first + size - 1) / ChunkSize + 1) : firstChunk;
+		for (ArrInt i = 0; i < chunks.Size(); i++) {
+			if ((i < firstChunk || i >= endChunk) && chunks[i]) {
+				std::allocator<T>().deallocate(chunks[i], ChunkSize);
+				chunks[i] = nullptr;
+			}
+		}
+	}
+
+	/* Swap the contents of two arrays without moving any elements. */
+	constexpr void Swap(chunked_darray& other) noexcept
+	{
+		chunks.Swap(other.chunks);
+		std::swap(first, other.first);
+		std::swap(size, other.size);
+	}
+
+	/* Call a function on each contiguous run of elements, in order. Each run is the part of a chunk holding elements.
+	@param func: Callable taking (T* elements, ArrInt count). */
+	template<typename Func>
+	constexpr void ForEachChunk(Func&& func) const
+	{
+		ArrInt slot = first;
+		const ArrInt end = first + size;
+		while (slot < end) {
+			const ArrInt chunkEnd = ArrInt((slot / ChunkSize + 1) * ChunkSize);
+			const ArrInt runEnd = chunkEnd < end ? chunkEnd : end;
+			func(Slot(slot), runEnd - slot);
+			slot = runEnd;
+		}
+	}
+
+	/* Call a function on every element, in order, iterating each chunk as a contiguous block.
+	@param func: Callable taking T&. */
+	template<typename Func>
+	constexpr void ForEach(Func&& func) const
+	{
+		ForEachChunk([&](T* elements, ArrInt count) {
+			for (ArrInt i = 0; i < count; i++) {
+				func(elements[i]);
+			}
+		});
+	}
+};
@@ -0,0 +1,90 @@
+#include "ConcurrentArray.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <types/test/UnitTest.h>
+
+#if RUNTIME_UNIT_TESTS == true
+namespace ConcurrentArrayRuntimeUnitTests
+{
+	constexpr int PRODUCERS = 4;
+
+	constexpr int ADDS_PER_PRODUCER = 5000;
+
+	/* Many threads adding at once get unique indices, and every value lands in the array exactly once,
+	across many segments. A reader running at the same time only ever sees a growing size, with every element below it constructed. */
+	static void ConcurrentAddTests()
+	{
+		concurrent_darray<int> arr;
+		std::atomic<bool> producing = true;
+		std::atomic<bool> readerFailed = false;
+		std::thread reader([&]() {
+			ArrInt lastSize = 0;
+			while (producing.load()) {
+				const ArrInt size = arr.Size();
+				if (size < lastSize) {
+					readerFailed = true;
+				}
+				for (ArrInt i = lastSize; i < size; i++) {
+					const int value = arr[i];
+					if (value < 0 || value >= PRODUCERS * ADDS_PER_PRODUCER) {
+						readerFailed = true;
+					}
+				}
+				lastSize = size;
+			}
+		});
+
+		std::unique_ptr<std::atomic<int>[]> indexUses(new std::atomic<int>[PRODUCERS * ADDS_PER_PRODUCER]());
+		darray<std::thread> producers;
+		for (int p = 0; p < PRODUCERS; p++) {
+			producers.Add(std::thread([&, p]() {
+				for (int i = 0; i < ADDS_PER_PRODUCER; i++) {
+					const ArrInt index = arr.Add(p * ADDS_PER_PRODUCER + i);
+					if (index < ArrInt(PRODUCERS * ADDS_PER_PRODUCER)) {
+						indexUses[index]++;
+					}
+				}
+			}));
+		}
+		for (ArrInt i = 0; i < producers.Size(); i++) {
+			producers[i].join();
+		}
+		producing = false;
+		reader.join();
+
+		RUNTIME_TEST_ASSERT(!readerFailed);
+		RUNTIME_TEST_ASSERT(arr.Size() == ArrInt(PRODUCERS * ADDS_PER_PRODUCER));
+		std::unique_ptr<int[]> valueCounts(new int[PRODUCERS * ADDS_PER_PRODUCER]());
+		const ArrInt visited = arr.ForEach([&](int& value) { valueCounts[value]++; });
+		RUNTIME_TEST_ASSERT(visited == arr.Size());
+		for (int i = 0; i < PRODUCERS * ADDS_PER_PRODUCER; i++) {
+			RUNTIME_TEST_ASSERT(valueCounts[i] == 1 && indexUses[i] == 1);
+		}
+	}
+	RUNTIME_TEST_SUITE(ConcurrentAddTests);
+
+	/* Elements never move as segments are added, and each segment holds a contiguous run of indices. */
+	static void ConcurrentSegmentTests()
+	{
+		concurrent_darray<std::string> arr;
+		RUNTIME_TEST_ASSERT(arr.Size() == 0 && arr.ForEach([](std::string&) {}) == 0);
+		arr.Reserve(10);
+		darray<const std::string*> addresses;
+		for (int i = 0; i < 1000; i++) {
+			RUNTIME_TEST_ASSERT(arr.Add(std::string(30, 'x') + std::to_string(i)) == ArrInt(i));
+			addresses.Add(&arr[ArrInt(i)]);
+		}
+		RUNTIME_TEST_ASSERT(arr.Size() == 1000);
+		for (ArrInt i = 0; i < 1000; i++) {
+			RUNTIME_TEST_ASSERT(&arr[i] == addresses[i] && arr[i] == std::string(30, 'x') + std::to_string(i));
+		}
+		// Segments of 64, 128, 256 and 512 elements. Neighbours within a segment are adjacent, and a new segment starts elsewhere.
+		const ArrInt segmentStarts[] = { 64, 192, 448, 960 };
+		for (ArrInt start : segmentStarts) {
+			RUNTIME_TEST_ASSERT(&arr[start - 2] + 1 == &arr[start - 1] && &arr[start + 1] == &arr[start] + 1);
+		}
+	}
+	RUNTIME_TEST_SUITE(ConcurrentSegmentTests);
+}
+#endif
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <new>
+#include <types/array/DynamicArray.h>
+
+/* Capacity of a concurrent_darray's first segment. Each following segment doubles in size. Must be a power of 2. */
+constexpr ArrInt CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE = 64;
+
+/*
+Append only array that many threads can add to at once without locking.
+Elements are stored in segments of doubling size that are never moved, so pointers and references to elements stay valid while the array grows.
+
+Add() reserves a slot with a single atomic increment, constructs the element in it, and then publishes it.
+Size() only counts the published elements that have every element before them published as well,
+so readers can safely access and iterate any index below it while other threads keep adding.
+Elements are never removed. The array must not be destroyed while any thread is still adding to it.
+Optionally disable out of bounds checks for indexing by setting the ARRAY_CHECK_OUT_OF_BOUNDS macro to false. See darray.
+
+@param - T: Type the array contains
+*/
+template<typename T>
+struct concurrent_darray
+{
+	static_assert(std::has_single_bit(CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE), "CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE must be a power of 2");
+
+private:
+
+	static constexpr ArrInt FIRST_SEGMENT_SHIFT = std::countr_zero(CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE);
+
+	/* Enough segments to address every index of the array size type. */
+	static constexpr ArrInt MAX_SEGMENTS = sizeof(ArrInt) * 8 - FIRST_SEGMENT_SHIFT;
+
+	/* Segments are aligned to a cache line, so the start of a new segment doesn't share one with anything else. */
+	static constexpr size_t SEGMENT_ALIGNMENT = alignof(T) > 64 ? alignof(T) : 64;
+
+	/* Each segment holds it's elements, followed by one ready flag per element. Allocated the first time an index within it is reserved. */
+	std::atomic<T*> segments[MAX_SEGMENTS];
+
+	/* Amount of slots handed out by Add(). */
+	alignas(64) std::atomic<ArrInt> reserved;
+
+	/* Amount of elements from the start that are all constructed. Kept on it's own cache line, away from the writers' counter. */
+	alignas(64) std::atomic<ArrInt> published;
+
+	/* Display an error message and abort the program. */
+	static void ArrayError(const char* errorMessage)
+	{
+		_ArrayError(errorMessage);
+		abort();
+	}
+
+	/* Segment holding an index. Segment k starts at FIRST_SEGMENT_SIZE * (2^k - 1).
+	Add() never reserves the indices near the max that would wrap around, but the compiler can't know that, so the segment is clamped
+	to keep every segments[] access provably in bounds (release builds otherwise warn with -Warray-bounds). */
+	static constexpr ArrInt SegmentOf(ArrInt index)
+	{
+		const ArrInt segment = ArrInt(std::bit_width(index + CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE)) - 1 - FIRST_SEGMENT_SHIFT;
+		return segment < MAX_SEGMENTS ? segment : MAX_SEGMENTS - 1;
+	}
+
+	/* Index of a segment's first element. */
+	static constexpr ArrInt SegmentStart(ArrInt segment)
+	{
+		return (CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE << segment) - CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE;
+	}
+
+	/* Amount of elements a segment holds. */
+	static constexpr ArrInt SegmentCapacity(ArrInt segment)
+	{
+		return CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE << segment;
+	}
+
+	/* Per element flags of a segment, set once the element is constructed. */
+	static std::atomic<bool>* ReadyFlags(T* segmentData, ArrInt segment)
+	{
+		return reinterpret_cast<std::atomic<bool>*>(segmentData + SegmentCapacity(segment));
+	}
+
+	/* Get a segment, allocating it if no other thread has yet. If two threads race to allocate it, the loser frees it's copy. */
+	T* GetOrAllocateSegment(ArrInt segment)
+	{
+		T* segmentData = segments[segment].load(std::memory_order_acquire);
+		if (segmentData) {
+			return segmentData;
+		}
+
+		const ArrInt count = SegmentCapacity(segment);
+		T* newSegment = static_cast<T*>(::operator new(count * (sizeof(T) + sizeof(std::atomic<bool>)), std::align_val_t(SEGMENT_ALIGNMENT)));
+		std::atomic<bool>* flags = ReadyFlags(newSegment, segment);
+		for (ArrInt i = 0; i < count; i++) {
+			new (flags + i) std::atomic<bool>(false);
+		}
+
+		if (segments[segment].compare_exchange_strong(segmentData, newSegment, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			return newSegment;
+		}
+		::operator delete(static_cast<void*>(newSegment), std::align_val_t(SEGMENT_ALIGNMENT));
+		return segmentData;
+	}
+
+	/* Advance the published size past a newly constructed element, and past any elements after it that were constructed before it. */
+	void Publish(ArrInt index)
+	{
+		while (true) {
+			ArrInt expected = index;
+			if (!published.compare_exchange_strong(expected, index + 1, std::memory_order_seq_cst)) {
+				// An earlier element is still being constructed. It's writer will publish this one.
+				return;
+			}
+			index++;
+			if (index >= reserved.load(std::memory_order_seq_cst)) {
+				return;
+			}
+			const ArrInt segment = SegmentOf(index);
+			T* segmentData = segments[segment].load(std::memory_order_acquire);
+			if (segmentData == nullptr || !ReadyFlags(segmentData, segment)[index - SegmentStart(segment)].load(std::memory_order_seq_cst)) {
+				return;
+			}
+		}
+	}
+
+	/* Reserve a slot, construct an element in it from args, and publish it. */
+	template<typename... Args>
+	ArrInt AddImpl(Args&&... args)
+	{
+		const ArrInt index = reserved.fetch_add(1, std::memory_order_relaxed);
+		if (index > ARRAY_MAX_CAPACITY - CONCURRENT_DARRAY_FIRST_SEGMENT_SIZE) {
+			ArrayError("Array capacity overflow from concurrent_darray::Add(). Too many elements for the array size type.");
+		}
+
+		const ArrInt segment = SegmentOf(index);
+		T* segmentData = GetOrAllocateSegment(segment);
+		const ArrInt offset = index - SegmentStart(segment);
+		new (segmentData + offset) T(std::forward<Args>(args)...);
+		ReadyFlags(segmentData, segment)[offset].store(true, std::memory_order_seq_cst);
+		Publish(index);
+		return index;
+	}
+
+	/* Get an element without bounds checking. The index's segment must be allocated. */
+	T& Element(ArrInt index) const
+	{
+		const ArrInt segment = SegmentOf(index);
+		return segments[segment].load(std::memory_order_acquire)[index - SegmentStart(segment)];
+	}
+
+public:
+
+	/* Default constructor. Does not allocate until the first element is added. */
+	concurrent_darray()
+	{
+		for (ArrInt i = 0; i < MAX_SEGMENTS; i++) {
+			segments[i].store(nullptr, std::memory_order_relaxed);
+		}
+		reserved.store(0, std::memory_order_relaxed);
+		published.store(0, std::memory_order_relaxed);
+	}
+
+	concurrent_darray(const concurrent_darray&) = delete;
+	void operator = (const concurrent_darray&) = delete;
+
+	/* Destructor. Calls the destructors of all the stored elements, then frees every segment.
+	Every Add() must have returned before the array is destroyed. */
+	~concurrent_darray()
+	{
+		const ArrInt count = reserved.load(std::memory_order_acquire);
+		for (ArrInt segment = 0; segment < MAX_SEGMENTS; segment++) {
+			T* segmentData = segments[segment].load(std::memory_order_acquire);
+			if (segmentData == nullptr) {
+				continue;
+			}
+			const ArrInt start = SegmentStart(segment);
+			if (start < count) {
+				const ArrInt segmentCount = count - start < SegmentCapacity(segment) ? count - start : SegmentCapacity(segment);
+				std::destroy_n(segmentData, segmentCount);
+			}
+			::operator delete(static_cast<void*>(segmentData), std::align_val_t(SEGMENT_ALIGNMENT));
+		}
+	}
+
+	/* Add an element to the end of the array by const ref. Safe to call from any amount of threads at once.
+	@returns Index of the added element. It becomes visible to Size() once every element before it is added too. */
+	ArrInt Add(const T& value)
+	{
+		return AddImpl(value);
+	}
+
+	/* Add an element to the end of the array by r value reference. Safe to call from any amount of threads at once.
+	@returns Index of the added element. It becomes visible to Size() once every element before it is added too. */
+	ArrInt Add(T&& value)
+	{
+		return AddImpl(std::move(value));
+	}
+
+	/* Allocate every segment needed to hold a capacity of elements, so later adds below it never allocate. Safe to call while other threads add. */
+	void Reserve(ArrInt newCapacity)
+	{
+		if (newCapacity == 0) {
+			return;
+		}
+		const ArrInt lastSegment = SegmentOf(newCapacity - 1);
+		for (ArrInt segment = 0; segment <= lastSegment; segment++) {
+			GetOrAllocateSegment(segment);
+		}
+	}
+
+	/* Get the amount of published elements. Every index below it is fully constructed and safe to read from any thread. */
+	ArrInt Size() const { return published.load(std::memory_order_acquire); }
+
+	/* Get a reference to a published element. Will only check if correct index if ARRAY_CHECK_OUT_OF_BOUNDS macro is set.
+	The reference stays valid for the lifetime of the array. */
+	T& At(ArrInt index)
+	{
+		#if ARRAY_CHECK_OUT_OF_BOUNDS == true
+		if (index >= Size()) {
+			ArrayError("Index out of bounds from concurrent_darray::At(). The index may not be published yet.");
+		}
+		#endif
+		return Element(index);
+	}
+
+	/* Index of operator. See At(). */
+	T& operator [] (ArrInt index)
+	{
+		return At(index);
+	}
+
+	/* Call a function on every element published at the time of calling, in index order. Runs over each segment as a contiguous block.
+	@param func: Callable taking T&.
+	@returns Amount of elements visited. */
+	template<typename Func>
+	ArrInt ForEach(Func&& func)
+	{
+		const ArrInt count = Size();
+		for (ArrInt segment = 0; segment < MAX_SEGMENTS && SegmentStart(segment) < count; segment++) {
+			T* segmentData = segments[segment].load(std::memory_order_acquire);
+			const ArrInt start = SegmentStart(segment);
+			const ArrInt end = count - start < SegmentCapacity(segment) ? count : start + SegmentCapacity(segment);
+			for (ArrInt i = 0; i < end - start; i++) {
+				func(segmentData[i]);
+			}
+		}
+		return count;
+	}
+};
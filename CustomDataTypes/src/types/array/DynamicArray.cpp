@@ -1,19 +1,17 @@
 #include "DynamicArray.h"
 #include <iostream>
+#include <limits>
+#include <string>
+#include <types/allocator/ArenaAllocator.h>
+#include <types/allocator/PoolAllocator.h>
+#include <types/array/SmallArray.h>
+#include <types/test/UnitTest.h>
 
 void _ArrayError(const char* errorMessage) 
 {
 	std::cout << "[ARRAY ERROR]: " << errorMessage << '\n';
 }
 
-#define _pragmsg(s) _Pragma(#s)
-#define PRAGMA_MESSAGE(msg) _pragmsg(message(#msg))
-
-#define TEST_ASSERT(test) \
-PRAGMA_MESSAGE([RUN UNIT TEST]:  test);	\
-static_assert(test, "[Array Compile Unit Test]: " #test)
-
-#define RUN_UNIT_TESTS_AT_COMPILE
 #ifdef RUN_UNIT_TESTS_AT_COMPILE
 namespace DArrayCompileUnitTests
 {
@@ -163,8 +161,9 @@ namespace DArrayCompileUnitTests
 	constexpr bool ArrayRemoveAll() 
 	{
 		darray<int> arr = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		const int* oldData = arr.GetData();
 		arr.RemoveAll(4);
-		return arr.Size() == 18;
+		return arr.Size() == 18 && arr[3] == 5 && arr.GetData() == oldData;
 	}
 	TEST_ASSERT(ArrayRemoveAll());
 
@@ -246,5 +245,543 @@ namespace DArrayCompileUnitTests
 		return true;
 	}
 	TEST_ASSERT(ArrayFillWith());
+
+	/* Element type that counts how many times it's constructors and destructor are called. */
+	struct ConstructionCounter
+	{
+		int* constructions;
+		int* destructions;
+
+		constexpr ConstructionCounter() : constructions(nullptr), destructions(nullptr) {}
+		constexpr ConstructionCounter(int* c, int* d) : constructions(c), destructions(d) { (*constructions)++; }
+		constexpr ConstructionCounter(const ConstructionCounter& other) : constructions(other.constructions), destructions(other.destructions) { (*constructions)++; }
+		constexpr ConstructionCounter& operator = (const ConstructionCounter& other) = default;
+		constexpr ~ConstructionCounter() { if (destructions) (*destructions)++; }
+	};
+
+	/* Reserving capacity must not construct any elements, and every constructed element must be destroyed exactly once. */
+	constexpr bool ArrayReserveDoesNotConstruct() 
+	{
+		int constructions = 0;
+		int destructions = 0;
+		{
+			darray<ConstructionCounter> arr;
+			arr.Reserve(100);
+			if (constructions != 0) return false;
+			arr.Add(ConstructionCounter(&constructions, &destructions));
+			arr.Reserve(1000);
+		}
+		return constructions > 0 && constructions == destructions;
+	}
+	TEST_ASSERT(ArrayReserveDoesNotConstruct());
+
+	/* Grow the array while adding an element that references the arrays own data. */
+	constexpr bool ArrayAddSelfReference() 
+	{
+		darray<int> arr = { 5 };
+		for (int i = 0; i < 10; i++) {
+			arr.Add(arr[0]);
+		}
+		return arr.Size() == 11 && arr[10] == 5;
+	}
+	TEST_ASSERT(ArrayAddSelfReference());
+
+	/* Move an array into another, leaving the original empty but still usable. */
+	constexpr bool ArrayMove() 
+	{
+		darray<int> a = { 5, 4, 2, 6, 2, 5 };
+		const int* aData = a.GetData();
+		darray<int> b = std::move(a);
+		if (b.GetData() != aData || b.Size() != 6 || a.Size() != 0) return false;
+
+		darray<int> c;
+		c = std::move(b);
+		if (c.GetData() != aData || b.Size() != 0) return false;
+
+		a.Add(1);
+		b.Add(2);
+		return a[0] == 1 && b[0] == 2;
+	}
+	TEST_ASSERT(ArrayMove());
+
+	/* Swap the contents of two arrays without copying. */
+	constexpr bool ArraySwap() 
+	{
+		darray<int> a = { 1, 2, 3 };
+		darray<int> b = { 4, 5 };
+		a.Swap(b);
+		return a.Size() == 2 && b.Size() == 3 && a[0] == 4 && b[2] == 3;
+	}
+	TEST_ASSERT(ArraySwap());
+
+	/* Count the occurrences of an element, and get all of their indices. */
+	constexpr bool ArrayCountAndFindAll() 
+	{
+		darray<int> arr = { 200, 1, 1, 201, 1, 25, 52 };
+		darray<ArrInt> indices = arr.FindAllIndices(1);
+		return arr.CountOf(1) == 3 && indices.Size() == 3 && indices[0] == 1 && indices[2] == 4 && arr.CountOf(7) == 0;
+	}
+	TEST_ASSERT(ArrayCountAndFindAll());
+
+	/* Searching an empty array finds nothing. */
+	constexpr bool ArrayFindLastEmpty() 
+	{
+		darray<int> arr;
+		return arr.FindLast(1) == nullptr && !arr.Contains(1);
+	}
+	TEST_ASSERT(ArrayFindLastEmpty());
+
+	/* Remove all elements matching a predicate, maintaining order of all other elements. */
+	constexpr bool ArrayRemoveIf() 
+	{
+		darray<int> arr = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		const ArrInt removed = arr.RemoveIf([](const int& e) { return e % 2 == 0; });
+		return removed == 5 && arr.Size() == 5 && arr[0] == 1 && arr[2] == 5 && arr[4] == 9;
+	}
+	TEST_ASSERT(ArrayRemoveIf());
+
+	/* Remove an element by swapping the last element into it's place. */
+	constexpr bool ArraySwapRemove() 
+	{
+		darray<int> arr = { 1, 2, 3, 4, 5 };
+		int elem = 0;
+		arr.SwapRemoveAt(1, &elem);
+		if (elem != 2 || arr.Size() != 4 || arr[1] != 5) return false;
+		return arr.SwapRemove(3) && arr.Size() == 3 && arr[2] == 4 && !arr.SwapRemove(100);
+	}
+	TEST_ASSERT(ArraySwapRemove());
+
+	/* Remove many sorted indices at once, maintaining order of the leftover elements. */
+	constexpr bool ArrayRemoveIndices() 
+	{
+		darray<int> arr = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		darray<ArrInt> indices = { 0, 2, 5, 5, 9 };
+		const ArrInt removed = arr.RemoveIndices(indices);
+		return removed == 4 && arr.Size() == 6 && arr[0] == 1 && arr[1] == 3 && arr[2] == 4 && arr[3] == 6 && arr[5] == 8;
+	}
+	TEST_ASSERT(ArrayRemoveIndices());
+
+	/* Stateless allocator policies and disabled stats must not increase the size of the array. */
+	#if CONTAINER_STATS == false
+	TEST_ASSERT(sizeof(darray<int>) == sizeof(int*) + 2 * sizeof(ArrInt));
+	#endif
+
+	/* Stats count growth when enabled, and stay zero when disabled. */
+	constexpr bool ArrayStats()
+	{
+		darray<int> arr;
+		for (int i = 0; i < 100; i++) {
+			arr.Add(i);
+		}
+		const ContainerStats stats = arr.GetStats();
+		#if CONTAINER_STATS == true
+		return stats.allocations > 1 && stats.reallocations > 0 && stats.bytesCopied > 0 && darray<int>(arr).GetStats().allocations == 1;
+		#else
+		return stats.allocations == 0 && stats.reallocations == 0 && stats.bytesCopied == 0;
+		#endif
+	}
+	TEST_ASSERT(ArrayStats());
+
+	/* Capacity growth saturates at the max capacity instead of overflowing. */
+	TEST_ASSERT(_ArrayCapacityIncrease(ARRAY_MAX_CAPACITY - 10) == ARRAY_MAX_CAPACITY);
+	TEST_ASSERT(_ArrayCapacityIncrease(ARRAY_MAX_CAPACITY) == ARRAY_MAX_CAPACITY);
+	TEST_ASSERT(_ArrayCapacityIncrease(100) > 100);
+
+	/* Move between arrays using different capacity increase functions, handing over the data block. */
+	constexpr ArrInt ArrayTestCapacityIncrease(ArrInt currentCapacity) { return currentCapacity * 2 + 1; }
+	constexpr bool ArrayConvertingMove() 
+	{
+		darray<int> a = { 1, 2, 3 };
+		const int* aData = a.GetData();
+		darray<int, ArrayTestCapacityIncrease> b = std::move(a);
+		return b.GetData() == aData && b.Size() == 3 && a.Size() == 0;
+	}
+	TEST_ASSERT(ArrayConvertingMove());
+
+	/* Construct elements in place at the end and within the array, including from references to the array's own elements. */
+	constexpr bool ArrayEmplace()
+	{
+		darray<int> arr;
+		arr.Emplace(1);
+		arr.Emplace(3);
+		arr.EmplaceAt(1, 2);
+		arr.EmplaceAt(0, 0);
+		arr.EmplaceAt(4, 4);
+		for (int i = 0; i < 10; i++) {
+			arr.EmplaceAt(0, arr[arr.Size() - 1]);
+		}
+		return arr.Size() == 15 && arr[0] == 4 && arr[10] == 0 && arr[11] == 1 && arr[12] == 2 && arr[14] == 4;
+	}
+	TEST_ASSERT(ArrayEmplace());
+
+	/* Emplacing at the end must construct the element exactly once, without a temporary to copy from.
+	Every element constructed while emplacing within the array must be destroyed exactly once. */
+	constexpr bool ArrayEmplaceConstructsOnce()
+	{
+		int constructions = 0;
+		int destructions = 0;
+		{
+			darray<ConstructionCounter> arr;
+			arr.Reserve(4);
+			arr.Emplace(&constructions, &destructions);
+			if (constructions != 1 || destructions != 0) return false;
+			arr.EmplaceAt(0, &constructions, &destructions);
+			arr.EmplaceAt(1, &constructions, &destructions);
+			arr.EmplaceAt(1, arr[2]);
+			arr.EmplaceAt(0, &constructions, &destructions);
+			if (arr.Size() != 5) return false;
+		}
+		return constructions == destructions;
+	}
+	TEST_ASSERT(ArrayEmplaceConstructsOnce());
+
+	/* Move a range of elements onto the end of an array, including from the array itself. */
+	constexpr bool ArrayInsertElementsMove()
+	{
+		darray<darray<int>> arr;
+		darray<int> source[2] = { { 1, 2 }, { 3 } };
+		arr.InsertElementsMove(source, 2);
+		arr.InsertElementsMove(arr.GetData(), 2);
+		return arr.Size() == 4 && source[0].Size() == 0 && arr[0].Size() == 0 && arr[2].Size() == 2 && arr[3][0] == 3;
+	}
+	TEST_ASSERT(ArrayInsertElementsMove());
+
+	/* Add space for elements to be written directly. */
+	constexpr bool ArrayAddUninitialized()
+	{
+		darray<int> arr = { 1 };
+		int* added = arr.AddUninitialized(100);
+		for (int i = 0; i < 100; i++) {
+			added[i] = i;
+		}
+		return arr.Size() == 101 && arr.Capacity() >= 101 && arr[0] == 1 && arr[100] == 99;
+	}
+	TEST_ASSERT(ArrayAddUninitialized());
+}
+#endif
+
+#if RUNTIME_UNIT_TESTS == true
+namespace DArrayRuntimeUnitTests
+{
+	/* Arena bump allocation, freeing and resizing the most recent allocation, and Reset(). */
+	static void ArenaAllocatorTests()
+	{
+		ArenaAllocator arena(256);
+		char* a = static_cast<char*>(arena.Allocate(16, 1));
+		char* b = static_cast<char*>(arena.Allocate(16, 1));
+		RUNTIME_TEST_ASSERT(b == a + 16);
+		RUNTIME_TEST_ASSERT(arena.BytesUsed() == 32);
+
+		// Only the most recent allocation is reclaimed or resized.
+		arena.Free(a, 16);
+		RUNTIME_TEST_ASSERT(arena.BytesUsed() == 32);
+		RUNTIME_TEST_ASSERT(!arena.TryResize(a, 16, 32));
+		RUNTIME_TEST_ASSERT(arena.TryResize(b, 16, 48));
+		RUNTIME_TEST_ASSERT(arena.BytesUsed() == 64);
+		RUNTIME_TEST_ASSERT(!arena.TryResize(b, 48, 1024));
+		arena.Free(b, 48);
+		RUNTIME_TEST_ASSERT(arena.BytesUsed() == 16);
+		RUNTIME_TEST_ASSERT(arena.Allocate(8, 1) == b);
+
+		void* aligned = arena.Allocate(8, 64);
+		RUNTIME_TEST_ASSERT(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+
+		// Larger than a block gets it's own block.
+		void* big = arena.Allocate(1000, 1);
+		RUNTIME_TEST_ASSERT(big != nullptr && arena.BytesUsed() >= 1000);
+
+		arena.Reset();
+		RUNTIME_TEST_ASSERT(arena.BytesUsed() == 0);
+		RUNTIME_TEST_ASSERT(arena.Allocate(16, 1) != nullptr && arena.BytesUsed() == 16);
+	}
+	RUNTIME_TEST_SUITE(ArenaAllocatorTests);
+
+	/* An array that is the arena's most recent allocation grows in place. */
+	static void ArenaArrayTests()
+	{
+		ArenaAllocator arena;
+		darray<int, _ArrayCapacityIncrease, darray_arena_allocator<int>> arr{ darray_arena_allocator<int>(&arena) };
+		arr.Reserve(4);
+		const int* first = arr.GetData();
+		for (int i = 0; i < 1000; i++) {
+			arr.Add(i);
+		}
+		RUNTIME_TEST_ASSERT(arr.GetData() == first);
+		RUNTIME_TEST_ASSERT(arr.Size() == 1000 && arr[0] == 0 && arr[999] == 999);
+	}
+	RUNTIME_TEST_SUITE(ArenaArrayTests);
+
+	/* Pool blocks are aligned, distinct, and reused last in first out from the free list. */
+	static void PoolAllocatorTests()
+	{
+		PoolAllocator pool(20, 4);
+		RUNTIME_TEST_ASSERT(pool.BlockSize() % PoolAllocator::BLOCK_ALIGNMENT == 0 && pool.BlockSize() >= 20);
+
+		void* blocks[6];
+		for (int i = 0; i < 6; i++) {
+			blocks[i] = pool.Allocate();
+			RUNTIME_TEST_ASSERT(reinterpret_cast<uintptr_t>(blocks[i]) % PoolAllocator::BLOCK_ALIGNMENT == 0);
+			for (int j = 0; j < i; j++) {
+				RUNTIME_TEST_ASSERT(blocks[i] != blocks[j]);
+			}
+		}
+
+		pool.Free(blocks[2]);
+		pool.Free(blocks[4]);
+		RUNTIME_TEST_ASSERT(pool.Allocate() == blocks[4]);
+		RUNTIME_TEST_ASSERT(pool.Allocate() == blocks[2]);
+	}
+	RUNTIME_TEST_SUITE(PoolAllocatorTests);
+
+	/* Arrays that fit in a block come from the pool, and free back to it. */
+	static void PoolArrayTests()
+	{
+		PoolAllocator pool(64, 4);
+		void* expected = pool.Allocate();
+		pool.Free(expected);
+		{
+			darray<int, _ArrayCapacityIncrease, darray_pool_allocator<int>> arr{ darray_pool_allocator<int>(&pool) };
+			arr.Reserve(8);
+			RUNTIME_TEST_ASSERT(static_cast<void*>(arr.GetData()) == expected);
+			for (int i = 0; i < 100; i++) {
+				arr.Add(i);
+			}
+			RUNTIME_TEST_ASSERT(arr.Size() == 100 && arr[99] == 99);
+		}
+		RUNTIME_TEST_ASSERT(pool.Allocate() == expected);
+	}
+	RUNTIME_TEST_SUITE(PoolArrayTests);
+
+	/* Whether an array's elements are stored within the array object itself. */
+	template<typename Array>
+	static bool IsStoredInline(const Array& arr)
+	{
+		const char* data = reinterpret_cast<const char*>(arr.GetData());
+		const char* object = reinterpret_cast<const char*>(&arr);
+		return data >= object && data < object + sizeof(Array);
+	}
+
+	/* Heap allocated strings, so a lost or doubly destroyed element shows up as a leak or double free. */
+	static std::string LongString(int i)
+	{
+		return std::string(40, char('a' + i % 26)) + std::to_string(i);
+	}
+
+	/* Elements stay inline up to N, and spill to the heap past it with their values intact. */
+	static void SmallArraySpillTests()
+	{
+		small_darray<std::string, 4> arr;
+		RUNTIME_TEST_ASSERT(arr.Capacity() == 4 && IsStoredInline(arr));
+		for (int i = 0; i < 4; i++) {
+			arr.Add(LongString(i));
+		}
+		RUNTIME_TEST_ASSERT(arr.Capacity() == 4 && IsStoredInline(arr));
+		arr.Add(LongString(4));
+		RUNTIME_TEST_ASSERT(arr.Capacity() > 4 && !IsStoredInline(arr));
+		for (int i = 0; i < 5; i++) {
+			RUNTIME_TEST_ASSERT(arr[i] == LongString(i));
+		}
+	}
+	RUNTIME_TEST_SUITE(SmallArraySpillTests);
+
+	/* Moving between darray and small_darray hands over heap blocks, and moves inline elements out without losing any. */
+	static void SmallArrayConversionTests()
+	{
+		darray<std::string> heap;
+		for (int i = 0; i < 8; i++) {
+			heap.Add(LongString(i));
+		}
+		const std::string* heapData = heap.GetData();
+		small_darray<std::string, 4> fromHeap = std::move(heap);
+		RUNTIME_TEST_ASSERT(fromHeap.GetData() == heapData && fromHeap.Size() == 8 && heap.Size() == 0);
+
+		darray<std::string> backToHeap = std::move(fromHeap);
+		RUNTIME_TEST_ASSERT(backToHeap.GetData() == heapData && backToHeap.Size() == 8 && fromHeap.Size() == 0);
+		RUNTIME_TEST_ASSERT(backToHeap[7] == LongString(7));
+
+		small_darray<std::string, 4> inlined;
+		inlined.Add(LongString(0));
+		inlined.Add(LongString(1));
+		darray<std::string> fromInline = std::move(inlined);
+		RUNTIME_TEST_ASSERT(fromInline.Size() == 2 && inlined.Size() == 0 && fromInline[1] == LongString(1));
+
+		// A heap block is adopted even when the elements would fit inline.
+		darray<std::string> small = { LongString(2) };
+		const std::string* smallData = small.GetData();
+		small_darray<std::string, 4> fromSmall = std::move(small);
+		RUNTIME_TEST_ASSERT(fromSmall.GetData() == smallData && fromSmall.Size() == 1 && fromSmall[0] == LongString(2));
+
+		small_darray<std::string, 4> source;
+		source.Add(LongString(3));
+		small_darray<std::string, 4> moved = std::move(source);
+		RUNTIME_TEST_ASSERT(IsStoredInline(moved) && moved.Size() == 1 && moved[0] == LongString(3) && source.Size() == 0);
+	}
+	RUNTIME_TEST_SUITE(SmallArrayConversionTests);
+
+	/* Shrinking a spilled array that fits in N moves it back inline, and it keeps working from there. */
+	static void SmallArrayShrinkTests()
+	{
+		small_darray<std::string, 4> arr;
+		for (int i = 0; i < 6; i++) {
+			arr.Add(LongString(i));
+		}
+		arr.RemoveAt(5);
+		arr.RemoveAt(4);
+		arr.RemoveAt(0);
+		arr.Shrink();
+		RUNTIME_TEST_ASSERT(IsStoredInline(arr) && arr.Size() == 3 && arr[0] == LongString(1) && arr[2] == LongString(3));
+		arr.Add(LongString(4));
+		arr.Add(LongString(5));
+		RUNTIME_TEST_ASSERT(!IsStoredInline(arr) && arr.Size() == 5 && arr[0] == LongString(1) && arr[4] == LongString(5));
+	}
+	RUNTIME_TEST_SUITE(SmallArrayShrinkTests);
+
+	/* Moving elements into a shrunk inline array grows it within the inline storage, rather than relocating it onto itself. */
+	static void SmallArrayShrinkInsertMoveTests()
+	{
+		small_darray<std::string, 4> arr;
+		arr.Add(LongString(0));
+		arr.Shrink();
+		RUNTIME_TEST_ASSERT(IsStoredInline(arr) && arr.Capacity() == 1);
+		std::string source[] = { LongString(1), LongString(2) };
+		arr.InsertElementsMove(source, 2);
+		RUNTIME_TEST_ASSERT(IsStoredInline(arr) && arr.Size() == 3);
+		RUNTIME_TEST_ASSERT(arr[0] == LongString(0) && arr[1] == LongString(1) && arr[2] == LongString(2));
+		RUNTIME_TEST_ASSERT(source[0].empty() && source[1].empty());
+
+		// Elements of the array itself, moved in while it grows.
+		arr.Shrink();
+		arr.InsertElementsMove(arr.GetData() + 1, 1);
+		RUNTIME_TEST_ASSERT(IsStoredInline(arr) && arr.Size() == 4 && arr[0] == LongString(0) && arr[1].empty() && arr[3] == LongString(1));
+
+		// Spilling to the heap.
+		std::string more[] = { LongString(4), LongString(5) };
+		arr.InsertElementsMove(more, 2);
+		RUNTIME_TEST_ASSERT(!IsStoredInline(arr) && arr.Size() == 6 && arr[0] == LongString(0) && arr[3] == LongString(1) && arr[5] == LongString(5));
+	}
+	RUNTIME_TEST_SUITE(SmallArrayShrinkInsertMoveTests);
+
+	/* Copies of an inline array get their own inline storage. */
+	static void SmallArrayCopyTests()
+	{
+		small_darray<std::string, 4> arr;
+		arr.Add(LongString(0));
+		arr.Add(LongString(1));
+		small_darray<std::string, 4> copy = arr;
+		RUNTIME_TEST_ASSERT(IsStoredInline(copy) && copy.GetData() != arr.GetData());
+		copy[0] = LongString(9);
+		RUNTIME_TEST_ASSERT(arr[0] == LongString(0) && copy[0] == LongString(9) && copy[1] == LongString(1));
+
+		small_darray<std::string, 4> assigned;
+		assigned.Add(LongString(5));
+		assigned = arr;
+		RUNTIME_TEST_ASSERT(IsStoredInline(assigned) && assigned.Size() == 2 && assigned[1] == LongString(1));
+	}
+	RUNTIME_TEST_SUITE(SmallArrayCopyTests);
+}
+#endif
+
+#if RUNTIME_UNIT_TESTS == true
+namespace ArraySearchRuntimeUnitTests
+{
+	/* Distinct values of any searchable type. Pointers point into a shared array. */
+	template<typename T>
+	static T SearchValue(int k)
+	{
+		if constexpr (std::is_pointer_v<T>) {
+			static int targets[4];
+			return static_cast<T>(targets + k);
+		}
+		else {
+			return T(k);
+		}
+	}
+
+	/* Compare every kernel against a scalar loop, on every count up to a few vectors past the widest vector, from an aligned and an unaligned start,
+	so each vector loop, it's tail, and the darray searches that dispatch to them are all reached. */
+	template<typename T>
+	static void CheckSearchKernels()
+	{
+		for (size_t count = 0; count <= 140; count++) {
+			darray<T> arr;
+			for (size_t i = 0; i < count + 1; i++) {
+				arr.Add(SearchValue<T>((i * 7 + count) % 11 == 0 ? 1 : 0));
+			}
+			// 2 appears once, at a position that moves through the vectors and tails as count grows.
+			if (count > 0) {
+				arr[ArrInt(1 + (count * 5) % count)] = SearchValue<T>(2);
+			}
+
+			for (size_t offset = 0; offset <= 1; offset++) {
+				const T* data = arr.GetData() + offset;
+				const size_t length = count + 1 - offset;
+				for (int k = 0; k <= 3; k++) {
+					const T value = SearchValue<T>(k);
+					size_t expectedCount = 0;
+					size_t expectedFirst = length;
+					size_t expectedSecond = length;
+					size_t expectedLast = length;
+					for (size_t i = 0; i < length; i++) {
+						if (data[i] == value) {
+							expectedCount++;
+							if (expectedCount == 1) expectedFirst = i;
+							if (expectedCount == 2) expectedSecond = i;
+							expectedLast = i;
+						}
+					}
+					RUNTIME_TEST_ASSERT(ArraySearch::FindFirst(data, length, value) == expectedFirst);
+					RUNTIME_TEST_ASSERT(ArraySearch::FindFirst(data, length, value, 2) == expectedSecond);
+					RUNTIME_TEST_ASSERT(ArraySearch::FindLast(data, length, value) == expectedLast);
+					RUNTIME_TEST_ASSERT(ArraySearch::Count(data, length, value) == expectedCount);
+
+					size_t matches = 0;
+					size_t previous = 0;
+					bool inOrder = true;
+					ArraySearch::ForEachMatch(data, length, value, [&](size_t index) {
+						inOrder = inOrder && index < length && data[index] == value && (matches == 0 || index > previous);
+						previous = index;
+						matches++;
+					});
+					RUNTIME_TEST_ASSERT(inOrder && matches == expectedCount);
+				}
+			}
+
+			ArrInt index = 0;
+			const bool found = arr.Contains(SearchValue<T>(2), &index);
+			RUNTIME_TEST_ASSERT(found == (count > 0) && (!found || arr[index] == SearchValue<T>(2)));
+			RUNTIME_TEST_ASSERT(arr.CountOf(SearchValue<T>(3)) == 0 && !arr.Contains(SearchValue<T>(3)));
+		}
+	}
+
+	/* Every element width, signed and unsigned, floating point and pointer types. */
+	static void SearchKernelTests()
+	{
+		CheckSearchKernels<signed char>();
+		CheckSearchKernels<unsigned char>();
+		CheckSearchKernels<short>();
+		CheckSearchKernels<unsigned short>();
+		CheckSearchKernels<int>();
+		CheckSearchKernels<unsigned int>();
+		CheckSearchKernels<long long>();
+		CheckSearchKernels<unsigned long long>();
+		CheckSearchKernels<float>();
+		CheckSearchKernels<double>();
+		CheckSearchKernels<int*>();
+		CheckSearchKernels<const void*>();
+	}
+	RUNTIME_TEST_SUITE(SearchKernelTests);
+
+	/* Floats match with operator == semantics in the vector kernels too. */
+	static void SearchFloatSemanticsTests()
+	{
+		darray<double> arr;
+		for (int i = 0; i < 40; i++) {
+			arr.Add(i == 37 ? -0.0 : std::numeric_limits<double>::quiet_NaN());
+		}
+		RUNTIME_TEST_ASSERT(ArraySearch::FindFirst(arr.GetData(), 40, 0.0) == 37);
+		RUNTIME_TEST_ASSERT(ArraySearch::Count(arr.GetData(), 40, std::numeric_limits<double>::quiet_NaN()) == 0);
+		RUNTIME_TEST_ASSERT(!arr.Contains(std::numeric_limits<double>::quiet_NaN()));
+	}
+	RUNTIME_TEST_SUITE(SearchFloatSemanticsTests);
 }
 #endif
@@ -1,13 +1,36 @@
 #pragma once
 
 #include <utility>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <concepts>
+#include <cstring>
+#include <cstdlib>
+#include <types/allocator/Allocator.h>
+#include <types/stats/ContainerStats.h>
+#include <types/array/ArraySearch.h>
 
 #ifndef ARRAY_CHECK_OUT_OF_BOUNDS
 #define ARRAY_CHECK_OUT_OF_BOUNDS true
 #endif
 
+/* Use a 64 bit size type, allowing arrays of more than 4G elements at the cost of 8 extra bytes per array.
+Must be set the same way for every translation unit, by doing
+-- #define ARRAY_64_BIT_SIZE true -- before including this array header, or through the project's preprocessor definitions. */
+#ifndef ARRAY_64_BIT_SIZE
+#define ARRAY_64_BIT_SIZE false
+#endif
+
 /* Integer size type for array. */
+#if ARRAY_64_BIT_SIZE == true
+typedef unsigned long long ArrInt;
+#else
 typedef unsigned int ArrInt;
+#endif
+
+/* Largest capacity an array can have. */
+constexpr ArrInt ARRAY_MAX_CAPACITY = ~ArrInt(0);
 
 /* Function pointer of function that will output the new capacity value from the current one, when increasing size. */
 typedef ArrInt (*darray_cap_inc)(ArrInt);
@@ -24,12 +47,22 @@ constexpr ArrInt _ArrayCapacityIncrease(ArrInt currentCapacity)
 		return (currentCapacity + 1) * 2;
 	}
 	else {
-		return ArrInt(double(currentCapacity) * 1.618);
+		// Golden ratio growth, saturating at the max capacity instead of overflowing.
+		const ArrInt increase = ArrInt(double(currentCapacity) * 0.618);
+		if (increase > ARRAY_MAX_CAPACITY - currentCapacity) {
+			return ARRAY_MAX_CAPACITY;
+		}
+		return currentCapacity + increase;
 	}
 }
 
 constexpr ArrInt _DARRAY_INITIAL_CAPACITY = 1;
 
+/* Whether a type can be moved to another memory location with a raw memcpy, skipping it's move constructor and destructor.
+Defaults to trivially copyable types. Specialize for types that own heap memory, but never hold pointers into themselves. */
+template<typename T>
+struct darray_trivially_relocatable : std::is_trivially_copyable<T> {};
+
 /*
 Array of dynamically changing size.
 Optionally disable out of bounds checks for indexing 
@@ -38,10 +71,12 @@ by setting the ARRAY_CHECK_OUT_OF_BOUNDS macro to false by doing
 
 @param - T: Type the array contains
 @param - capacityInc (optional. default _ArrayCapacityIncrease): Pointer to a function that returns a new capacity from the current one for increasing.
+@param - Allocator (optional. default darray_allocator): Allocator policy the data block is allocated from. See darray_allocator.
 */
 template<
 	typename T,
-	darray_cap_inc capacityInc = _ArrayCapacityIncrease>
+	darray_cap_inc capacityInc = _ArrayCapacityIncrease,
+	typename Allocator = darray_allocator<T>>
 struct darray
 {
 private:
@@ -55,6 +90,20 @@ private:
 	/* The amount of elements that this array can hold without reallocation. */
 	ArrInt capacity;
 
+	/* Allocator policy instance. Occupies no space for stateless allocators. */
+	DARRAY_NO_UNIQUE_ADDRESS Allocator allocator;
+
+	/* Allocation and copy counters. Occupies no space unless CONTAINER_STATS is enabled. */
+	DARRAY_NO_UNIQUE_ADDRESS container_stats_tracker stats;
+
+	/* Arrays using other capacity increase functions or allocators can take each other's data blocks. */
+	template<typename, darray_cap_inc, typename>
+	friend struct darray;
+
+	/* Structure of arrays shares the element construction and relocation helpers for it's columns. */
+	template<typename...>
+	friend struct darray_soa;
+
 public:
 
 	/* Array custom iterator. */
@@ -80,41 +129,76 @@ public:
 	/* Default constructor */
 	constexpr darray()
 	{
-		data = new T[_DARRAY_INITIAL_CAPACITY];
-		capacity = _DARRAY_INITIAL_CAPACITY;
+		data = AllocateData(InitialCapacity());
+		capacity = InitialCapacity();
+		size = 0;
+	}
+
+	/* Construct with a specific allocator instance, such as one referencing an arena. */
+	constexpr explicit darray(const Allocator& _allocator)
+		: allocator(_allocator)
+	{
+		data = AllocateData(InitialCapacity());
+		capacity = InitialCapacity();
 		size = 0;
 	}
 
 	/* Initializer list constructor */
-	constexpr darray(const std::initializer_list<T>& il)
+	constexpr darray(const std::initializer_list<T>& il, const Allocator& _allocator = Allocator())
+		: allocator(_allocator)
 	{
 		size = il.size();
 		capacity = il.size();
 
-		data = new T[capacity];
-		ArrInt incrementor = 0;
-		for (const T& i : il) {
-			data[incrementor] = i;
-			incrementor++;
-		}
+		data = AllocateData(capacity);
+		CopyConstructElements(data, il.begin(), size);
+		stats.BytesCopied(sizeof(T) * size);
 	}
 
 	/* Copy constructor */
-	constexpr darray(const darray<T, capacityInc>& other)
+	constexpr darray(const darray<T, capacityInc, Allocator>& other)
+		: allocator(other.allocator)
 	{
 		capacity = other.capacity;
 		size = other.size;
-		data = new T[capacity];
+		data = AllocateData(capacity);
+		CopyConstructElements(data, other.data, size);
+		stats.BytesCopied(sizeof(T) * size);
+	}
 
-		for (ArrInt i = 0; i < size; i++) {
-			data[i] = other.data[i];
-		}
+	/* Move constructor. Takes ownership of the other array's data block without allocating or copying.
+	The other array is left empty with a capacity of 0.
+	If the other array's elements are stored inline within it's allocator, they are moved into this array's storage instead. */
+	constexpr darray(darray<T, capacityInc, Allocator>&& other) noexcept
+		: allocator(std::move(other.allocator))
+	{
+		TakeFrom(other);
 	}
 
-	/* Destructor. Does not call destructors of data held within. */
+	/* Copy construct from an array using a different capacity increase function or allocator. */
+	template<darray_cap_inc otherCapacityInc, typename OtherAllocator>
+	constexpr darray(const darray<T, otherCapacityInc, OtherAllocator>& other)
+	{
+		capacity = other.size > InitialCapacity() ? other.size : InitialCapacity();
+		size = other.size;
+		data = AllocateData(capacity);
+		CopyConstructElements(data, other.data, size);
+		stats.BytesCopied(sizeof(T) * size);
+	}
+
+	/* Move construct from an array using a different capacity increase function or allocator, such as small_darray.
+	Takes the other array's data block if this allocator is able to free it, otherwise moves the elements. */
+	template<darray_cap_inc otherCapacityInc, typename OtherAllocator>
+	constexpr darray(darray<T, otherCapacityInc, OtherAllocator>&& other)
+	{
+		TakeFrom(other);
+	}
+
+	/* Destructor. Calls the destructors of all the stored elements, then frees the data block. */
 	constexpr ~darray()
 	{
-		delete[] data;
+		DestroyElements(data, size);
+		FreeData(data, capacity);
 	}
 	
 	constexpr iterator begin() const { return iterator(data); }
@@ -122,10 +206,90 @@ public:
 
 private:
 
+	/* Capacity of newly constructed arrays. Allocators with inline storage start with all of it. */
+	static constexpr ArrInt InitialCapacity()
+	{
+		if constexpr (requires { Allocator::INITIAL_CAPACITY; }) {
+			return ArrInt(Allocator::INITIAL_CAPACITY);
+		}
+		else {
+			return _DARRAY_INITIAL_CAPACITY;
+		}
+	}
+
+	/* Whether the data block lives within the allocator itself, meaning it can't be handed to another array. */
+	constexpr bool IsDataInline() const
+	{
+		if constexpr (requires { allocator.IsInline(data); }) {
+			return allocator.IsInline(data);
+		}
+		else {
+			return false;
+		}
+	}
+
+	/* Whether this array's allocator can free the other array's data block. */
+	template<darray_cap_inc otherCapacityInc, typename OtherAllocator>
+	static constexpr bool CanAdoptData(const darray<T, otherCapacityInc, OtherAllocator>& other)
+	{
+		if constexpr (std::is_same_v<Allocator, OtherAllocator>) {
+			return !other.IsDataInline();
+		}
+		else if constexpr (requires { Allocator::USES_GLOBAL_HEAP; OtherAllocator::USES_GLOBAL_HEAP; }) {
+			return Allocator::USES_GLOBAL_HEAP && OtherAllocator::USES_GLOBAL_HEAP && !other.IsDataInline();
+		}
+		else {
+			return false;
+		}
+	}
+
+	/* Take the elements of another array. This array must not currently own a data block.
+	Takes the other array's data block when possible, leaving it with a capacity of 0.
+	Otherwise moves the elements into a new block, leaving the other array empty but keeping it's block. */
+	template<darray_cap_inc otherCapacityInc, typename OtherAllocator>
+	constexpr void TakeFrom(darray<T, otherCapacityInc, OtherAllocator>& other)
+	{
+		if (CanAdoptData(other)) {
+			data = other.data;
+			size = other.size;
+			capacity = other.capacity;
+			other.data = nullptr;
+			other.size = 0;
+			other.capacity = 0;
+			return;
+		}
+
+		capacity = other.size > InitialCapacity() ? other.size : InitialCapacity();
+		size = other.size;
+		data = AllocateData(capacity);
+		RelocateElements(data, other.data, size);
+		stats.BytesCopied(sizeof(T) * size);
+		other.size = 0;
+	}
+
+	/* Get the next capacity from the provided capacity allocator. Errors if the capacity can't grow any further. */
+	constexpr ArrInt NextCapacity() 
+	{
+		const ArrInt newCapacity = capacityInc(capacity);
+		if (newCapacity <= capacity) {
+			ArrayError("Array capacity overflow from Array::NextCapacity(). The capacity increase function did not increase the capacity.");
+		}
+		return newCapacity;
+	}
+
+	/* Get the capacity required to store an extra amount of elements. Errors if it exceeds the max capacity. */
+	constexpr ArrInt RequiredCapacity(ArrInt extra) 
+	{
+		if (extra > ARRAY_MAX_CAPACITY - size) {
+			ArrayError("Array capacity overflow from Array::RequiredCapacity(). Too many elements for the array size type.");
+		}
+		return size + extra;
+	}
+
 	/* Increase the capacity of the array from the provided capacity allocator. */
 	constexpr void IncreaseCapacityFromAllocator() 
 	{ 
-		Reallocate(capacityInc(capacity));
+		Reallocate(NextCapacity());
 	}
 
 	/* Display an error message and abort the program.
@@ -136,26 +300,287 @@ private:
 		abort();
 	}
 
+	/* Allocate uninitialized storage for a specified amount of elements from the allocator. No constructors are called. */
+	constexpr T* AllocateData(ArrInt count)
+	{
+		if (count == 0) {
+			return nullptr;
+		}
+		stats.Allocation();
+		return allocator.Allocate(count);
+	}
+
+	/* Free storage previously returned by AllocateData(). Does not call any destructors. */
+	constexpr void FreeData(T* block, ArrInt count)
+	{
+		if (block) {
+			allocator.Free(block, count);
+		}
+	}
+
+	/* Whether the allocator can move the data block itself without copying, such as with mremap.
+	Only used for trivially relocatable types, since the bytes are moved without calling any constructors. */
+	static constexpr bool CanReallocateTrivial()
+	{
+		return darray_trivially_relocatable<T>::value
+			&& requires (Allocator a, T* block, size_t count) { { a.ReallocateTrivial(block, count, count) } -> std::same_as<T*>; };
+	}
+
+	/* Try to change the capacity of the data block through the allocator's ReallocateTrivial(), if it has one. */
+	constexpr bool TryReallocateTrivial(ArrInt newCapacity)
+	{
+		if constexpr (CanReallocateTrivial()) {
+			if (!std::is_constant_evaluated() && data && newCapacity > 0) {
+				T* newData = allocator.ReallocateTrivial(data, capacity, newCapacity);
+				if (newData) {
+					data = newData;
+					capacity = newCapacity;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	/* Try to change the capacity of the data block without moving it, if the allocator supports it. */
+	constexpr bool TryResizeInPlace(ArrInt newCapacity)
+	{
+		if constexpr (requires { allocator.TryResizeInPlace(data, capacity, newCapacity); }) {
+			if (data && newCapacity > 0 && allocator.TryResizeInPlace(data, capacity, newCapacity)) {
+				capacity = newCapacity;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/* Call the destructors of a range of constructed elements. No-op for trivially destructible types. */
+	static constexpr void DestroyElements(T* start, ArrInt count)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			std::destroy_n(start, count);
+		}
+	}
+
+	/* Copy construct a range of elements into uninitialized storage. Trivially copyable types use a single memcpy. */
+	static constexpr void CopyConstructElements(T* dest, const T* source, ArrInt count)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			if (!std::is_constant_evaluated()) {
+				if (count > 0) {
+					memcpy(dest, source, sizeof(T) * count);
+				}
+				return;
+			}
+		}
+		for (ArrInt i = 0; i < count; i++) {
+			std::construct_at(dest + i, source[i]);
+		}
+	}
+
+	/* Move a range of elements into uninitialized storage, ending the lifetime of the source elements.
+	Trivially relocatable types use a single memcpy. */
+	static constexpr void RelocateElements(T* dest, T* source, ArrInt count)
+	{
+		if constexpr (darray_trivially_relocatable<T>::value) {
+			if (!std::is_constant_evaluated()) {
+				if (count > 0) {
+					memcpy((void*)dest, (const void*)source, sizeof(T) * count);
+				}
+				return;
+			}
+		}
+		for (ArrInt i = 0; i < count; i++) {
+			std::construct_at(dest + i, std::move(source[i]));
+			std::destroy_at(source + i);
+		}
+	}
+
 	/* Reallocate the array to store a new capacity of elements.
-	If the new capacity is less than the current array size, array size is decreased to new capacity.
-	Be cautious of memory leaks due to array shrinking. */
+	Only the stored elements are relocated. The extra capacity is left uninitialized.
+	If the new capacity is less than the current array size, the elements past the new capacity are destroyed. */
 	constexpr void Reallocate(ArrInt newCapacity)
 	{
-		T* newData = new T[newCapacity];
-
 		if (newCapacity < size) {
+			DestroyElements(data + newCapacity, size - newCapacity);
 			size = newCapacity;
 		}
 
-		for (ArrInt i = 0; i < size; i++) {
-			newData[i] = std::move(data[i]);
+		if (data) {
+			stats.Reallocation();
+		}
+		if (TryResizeInPlace(newCapacity) || TryReallocateTrivial(newCapacity)) {
+			return;
 		}
 
-		delete[] data;
+		T* newData = AllocateData(newCapacity);
+		RelocateElements(newData, data, size);
+		stats.BytesCopied(sizeof(T) * size);
+		FreeData(data, capacity);
 		data = newData;
 		capacity = newCapacity;
 	}
 
+	/* Grow the array from the capacity allocator, constructing a new element at the end.
+	The new element is constructed before the old data is freed, so the arguments may reference elements in this array. */
+	template<typename... Args>
+	constexpr void GrowAndConstructBack(Args&&... args)
+	{
+		const ArrInt newCapacity = NextCapacity();
+		if (data) {
+			stats.Reallocation();
+		}
+		if (TryResizeInPlace(newCapacity)) {
+			std::construct_at(data + size, std::forward<Args>(args)...);
+			size++;
+			return;
+		}
+
+		if constexpr (CanReallocateTrivial()) {
+			if (!std::is_constant_evaluated()) {
+				// The arguments may reference elements in the block being moved, so the new element is created first.
+				T element(std::forward<Args>(args)...);
+				if (!TryReallocateTrivial(newCapacity)) {
+					T* newData = AllocateData(newCapacity);
+					RelocateElements(newData, data, size);
+					stats.BytesCopied(sizeof(T) * size);
+					FreeData(data, capacity);
+					data = newData;
+					capacity = newCapacity;
+				}
+				std::construct_at(data + size, std::move(element));
+				size++;
+				return;
+			}
+		}
+
+		T* newData = AllocateData(newCapacity);
+		std::construct_at(newData + size, std::forward<Args>(args)...);
+		RelocateElements(newData, data, size);
+		stats.BytesCopied(sizeof(T) * size);
+		FreeData(data, capacity);
+		data = newData;
+		capacity = newCapacity;
+		size++;
+	}
+
+	/* Grow the array from the capacity allocator, constructing a new element at an index within the stored elements.
+	The new element is constructed before the stored elements are relocated around it and the old data is freed,
+	so the arguments may reference elements in this array. */
+	template<typename... Args>
+	constexpr void GrowAndConstructAt(ArrInt index, Args&&... args)
+	{
+		const ArrInt newCapacity = NextCapacity();
+		stats.Reallocation();
+		if (TryResizeInPlace(newCapacity)) {
+			ShiftAndConstructAt(index, std::forward<Args>(args)...);
+			return;
+		}
+
+		T* newData = AllocateData(newCapacity);
+		std::construct_at(newData + index, std::forward<Args>(args)...);
+		RelocateElements(newData, data, index);
+		RelocateElements(newData + index + 1, data + index, size - index);
+		stats.BytesCopied(sizeof(T) * size);
+		FreeData(data, capacity);
+		data = newData;
+		capacity = newCapacity;
+		size++;
+	}
+
+	/* Construct a new element at an index within the stored elements, shifting every element after it over by 1. The array must have spare capacity.
+	The element is constructed before anything is shifted, so the arguments may reference elements in this array.
+	Trivially relocatable types are constructed once in a raw buffer, then placed into the gap left by a single memmove, without any copy or destruction.
+	Other types are moved from a temporary into the gap. */
+	template<typename... Args>
+	constexpr void ShiftAndConstructAt(ArrInt index, Args&&... args)
+	{
+		if constexpr (darray_trivially_relocatable<T>::value) {
+			if (!std::is_constant_evaluated()) {
+				alignas(T) unsigned char element[sizeof(T)];
+				std::construct_at(reinterpret_cast<T*>(element), std::forward<Args>(args)...);
+				memmove((void*)(data + index + 1), (const void*)(data + index), sizeof(T) * (size - index));
+				memcpy((void*)(data + index), element, sizeof(T));
+				size++;
+				return;
+			}
+		}
+
+		T element(std::forward<Args>(args)...);
+		std::construct_at(data + size, std::move(data[size - 1]));
+		for (ArrInt i = size - 1; i > index; i--) {
+			data[i] = std::move(data[i - 1]);
+		}
+		data[index] = std::move(element);
+		size++;
+	}
+
+	/* Remove a single element, shifting all elements after it over by 1 with a single block move. */
+	constexpr void EraseAt(ArrInt index)
+	{
+		std::move(data + index + 1, data + size, data + index);
+		size--;
+		std::destroy_at(data + size);
+	}
+
+	/* Remove every element after the first matching one that satisfies a predicate, moving each survivor at most once.
+	@param first: Index of the first element to remove.
+	@returns Amount of elements removed. */
+	template<typename Predicate>
+	constexpr ArrInt CompactFrom(ArrInt first, Predicate&& shouldRemove)
+	{
+		ArrInt write = first;
+		for (ArrInt read = first + 1; read < size; read++) {
+			if (!shouldRemove(data[read])) {
+				data[write] = std::move(data[read]);
+				write++;
+			}
+		}
+
+		const ArrInt amount = size - write;
+		DestroyElements(data + write, amount);
+		size = write;
+		return amount;
+	}
+
+	/* Index of the nth occurrence of an element, or size if not found.
+	Arithmetic and pointer types use the ArraySearch SIMD kernels at runtime. */
+	constexpr ArrInt SearchFirst(const T& element, ArrInt occurrence) const
+	{
+		if constexpr (ArraySearch::IsVectorizable<T>) {
+			if (!std::is_constant_evaluated()) {
+				return ArrInt(ArraySearch::FindFirst(data, size, element, occurrence));
+			}
+		}
+		ArrInt occurrenceCount = 1;
+		for (ArrInt i = 0; i < size; i++) {
+			if (element == data[i]) {
+				if (occurrenceCount == occurrence) {
+					return i;
+				}
+				occurrenceCount++;
+			}
+		}
+		return size;
+	}
+
+	/* Index of the last occurrence of an element, or size if not found.
+	Arithmetic and pointer types use the ArraySearch SIMD kernels at runtime. */
+	constexpr ArrInt SearchLast(const T& element) const
+	{
+		if constexpr (ArraySearch::IsVectorizable<T>) {
+			if (!std::is_constant_evaluated()) {
+				return ArrInt(ArraySearch::FindLast(data, size, element));
+			}
+		}
+		for (ArrInt i = size; i > 0; i--) {
+			if (element == data[i - 1]) {
+				return i - 1;
+			}
+		}
+		return size;
+	}
+
 public:
 
 	/* Get size of array. */
@@ -198,6 +623,9 @@ public:
 	@param extraCapacity: The amount to add to the array's current capacity. */
 	void ReserveExtra(ArrInt extraCapacity) 
 	{
+		if (extraCapacity > ARRAY_MAX_CAPACITY - capacity) {
+			ArrayError("Array capacity overflow from Array::ReserveExtra(). Too many elements for the array size type.");
+		}
 		Reallocate(capacity + extraCapacity);
 	}
 
@@ -205,9 +633,10 @@ public:
 	constexpr void Add(const T& value) 
 	{
 		if (size == capacity) {
-			IncreaseCapacityFromAllocator();
+			GrowAndConstructBack(value);
+			return;
 		}
-		data[size] = value;
+		std::construct_at(data + size, value);
 		size++;
 	}
 
@@ -215,25 +644,124 @@ public:
 	constexpr void Add(T&& value) 
 	{
 		if (size == capacity) {
-			IncreaseCapacityFromAllocator();
+			GrowAndConstructBack(std::move(value));
+			return;
 		}
-		data[size] = std::move(value);
+		std::construct_at(data + size, std::move(value));
 		size++;
 	}
 
+	/* Construct an element at the end of the array directly from constructor arguments, without any temporary.
+	The arguments may reference elements in this array.
+	@returns Reference to the new element. */
+	template<typename... Args>
+	constexpr T& Emplace(Args&&... args)
+	{
+		if (size == capacity) {
+			GrowAndConstructBack(std::forward<Args>(args)...);
+		}
+		else {
+			std::construct_at(data + size, std::forward<Args>(args)...);
+			size++;
+		}
+		return data[size - 1];
+	}
+
+	/* Construct an element at an index from constructor arguments, shifting all elements after it over by 1.
+	The arguments may reference elements in this array. Trivially relocatable types are constructed once, and never copied or assigned.
+	@param index: Index to construct at. May be equal to the size to construct at the end.
+	@returns Reference to the new element. */
+	template<typename... Args>
+	constexpr T& EmplaceAt(ArrInt index, Args&&... args)
+	{
+		if (index > size) {
+			ArrayError("Index out of bounds from Array::EmplaceAt().");
+		}
+		if (index == size) {
+			return Emplace(std::forward<Args>(args)...);
+		}
+
+		if (size == capacity) {
+			GrowAndConstructAt(index, std::forward<Args>(args)...);
+		}
+		else {
+			ShiftAndConstructAt(index, std::forward<Args>(args)...);
+		}
+		return data[index];
+	}
+
+	/* Add elements to the end of the array by moving them, leaving the source elements in a moved from state. Only performs one capacity increase.
+	The elements may be from this array.
+	@param start: Pointer to an array of T value(s).
+	@param amount: amount of T's to move in. */
+	constexpr void InsertElementsMove(T* start, ArrInt amount)
+	{
+		const ArrInt newSize = RequiredCapacity(amount);
+		T* dest = data;
+		if (newSize > capacity) {
+			if (data) {
+				stats.Reallocation();
+			}
+			// Resizing in place keeps small_darray's inline storage, which AllocateData() would hand back as the new block.
+			if (!TryResizeInPlace(newSize)) {
+				dest = AllocateData(newSize);
+			}
+		}
+
+		// The new elements are moved in before the old data is freed, since they may be in it.
+		for (ArrInt i = 0; i < amount; i++) {
+			std::construct_at(dest + size + i, std::move(start[i]));
+		}
+		if (dest != data) {
+			RelocateElements(dest, data, size);
+			stats.BytesCopied(sizeof(T) * size);
+			FreeData(data, capacity);
+			data = dest;
+			capacity = newSize;
+		}
+		stats.BytesCopied(sizeof(T) * amount);
+		size = newSize;
+	}
+
+	/* Add N elements to the end of the array without constructing them, so they can be written to directly, such as by a decoder.
+	Only available for types that don't need constructing or destructing. The elements are zeroed during constant evaluation.
+	@param amount: Amount of elements to add.
+	@returns Pointer to the first added element. Invalidated by any growth. */
+	constexpr T* AddUninitialized(ArrInt amount)
+		requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+	{
+		const ArrInt newSize = RequiredCapacity(amount);
+		if (newSize > capacity) {
+			ArrInt newCapacity = NextCapacity();
+			if (newCapacity < newSize) {
+				newCapacity = newSize;
+			}
+			Reallocate(newCapacity);
+		}
+
+		T* added = data + size;
+		if (std::is_constant_evaluated()) {
+			for (ArrInt i = 0; i < amount; i++) {
+				std::construct_at(added + i);
+			}
+		}
+		size = newSize;
+		return added;
+	}
+
 	/* Insert N elements from an initializer list. Only performs one capacity increase. 
 	@param il: Initializer list values. */
 	constexpr void InsertElements(const std::initializer_list<T>& il) 
 	{
 		const ArrInt ilSize = il.size();
-		if (size + ilSize >= capacity) {
-			Reallocate(size + ilSize);
+		const ArrInt newSize = RequiredCapacity(ilSize);
+		if (newSize > capacity) {
+			Reallocate(newSize);
 		}
 
-		for (const T& i : il) {
-			data[size] = i;
-			size++;
-		}
+		CopyConstructElements(data + size, il.begin(), ilSize);
+		stats.BytesCopied(sizeof(T) * ilSize);
+		size += ilSize;
 	}
 
 	/* Insert N elements from a specified start element. Only performs one capacity increase. 
@@ -241,14 +769,14 @@ public:
 	@param amount: amount of T's to insert. */
 	constexpr void InsertElements(const T* start, ArrInt amount)
 	{
-		if (size + amount >= capacity) {
-			Reallocate(size + amount);
+		const ArrInt newSize = RequiredCapacity(amount);
+		if (newSize > capacity) {
+			Reallocate(newSize);
 		}
 
-		for (int i = 0; i < amount; i++) {
-			data[size] = start[i];
-			size++;
-		}
+		CopyConstructElements(data + size, start, amount);
+		stats.BytesCopied(sizeof(T) * amount);
+		size += amount;
 	}
 
 	/* Insert N elements to this array of a type that can be statically cast to the array T type. 
@@ -257,32 +785,32 @@ public:
 	template<typename U>
 	constexpr void InsertElementsCast(const U* start, ArrInt amount) 
 	{
-		if (size + amount >= capacity) {
-			Reallocate(size + amount);
+		const ArrInt newSize = RequiredCapacity(amount);
+		if (newSize > capacity) {
+			Reallocate(newSize);
 		}
 
 		for (ArrInt i = 0; i < amount; i++) {
-			data[size] = static_cast<T>(start[i]);
+			std::construct_at(data + size, static_cast<T>(start[i]));
 			size++;
 		}
 	}
 
 	/* Add the contents of another array to this one. */
-	constexpr void AppendArray(const darray<T, capacityInc>& other) 
+	constexpr void AppendArray(const darray<T, capacityInc, Allocator>& other) 
 	{
-		const ArrInt newSize = size + other.size; 
+		const ArrInt newSize = RequiredCapacity(other.size);
 		if (newSize > capacity) {
 			Reallocate(newSize);
 		}
 
-		for (ArrInt i = 0; i < other.size; i++) {
-			data[size] = other.data[i];
-			size++;
-		}
+		CopyConstructElements(data + size, other.data, other.size);
+		stats.BytesCopied(sizeof(T) * other.size);
+		size = newSize;
 	}
 
 	/* Append another array to this one. */
-	constexpr void operator += (const darray<T, capacityInc>& other)
+	constexpr void operator += (const darray<T, capacityInc, Allocator>& other)
 	{
 		AppendArray(other);
 	}
@@ -292,15 +820,14 @@ public:
 	@param indexOut (optional): Pointer to array integer type to insert the found element index. */
 	constexpr bool Contains(const T& element, ArrInt* indexOut = nullptr) 
 	{
-		for (ArrInt i = 0; i < size; i++) {
-			if (element == At(i)) {
-				if (indexOut) {
-					*indexOut = i;
-				}
-				return true;
-			}
+		const ArrInt i = SearchFirst(element, 1);
+		if (i == size) {
+			return false;
 		}
-		return false;
+		if (indexOut) {
+			*indexOut = i;
+		}
+		return true;
 	}
 
 	/* Iterate through the entire array, checking if the element matches. 
@@ -311,21 +838,14 @@ public:
 	@returns Pointer to the found element. nullptr if not found. */
 	constexpr T* Find(const T& element, ArrInt* indexOut = nullptr, ArrInt occurrence = 1) 
 	{
-		ArrInt occurrenceCount = 1;
-		for (ArrInt i = 0; i < size; i++) {
-			if (element == At(i)) {
-				if (occurrenceCount == occurrence) {
-					if (indexOut) {
-						*indexOut = i;
-					}
-					return &At(i);
-				}
-				else {
-					occurrenceCount++;
-				}
-			}
+		const ArrInt i = SearchFirst(element, occurrence);
+		if (i == size) {
+			return nullptr;
 		}
-		return nullptr;
+		if (indexOut) {
+			*indexOut = i;
+		}
+		return data + i;
 	}
 
 	/* Iterate through the entire array from the end to front, checking if the element matches.
@@ -334,21 +854,53 @@ public:
 	@returns Pointer to the found element. nullptr if not found. */
 	constexpr T* FindLast(const T& element, ArrInt* indexOut = nullptr) 
 	{
-		bool reachedEnd = false;
-		ArrInt i = size - 1;
-		while (!reachedEnd) {
-			if (element == At(i)) {
-				if (indexOut) {
-					*indexOut = i;
-				}
-				return &At(i);
+		const ArrInt i = SearchLast(element);
+		if (i == size) {
+			return nullptr;
+		}
+		if (indexOut) {
+			*indexOut = i;
+		}
+		return data + i;
+	}
+
+	/* Count the amount of elements equal to a given element.
+	@param element: Comparison value.
+	@returns Amount of matching elements. */
+	constexpr ArrInt CountOf(const T& element) const
+	{
+		if constexpr (ArraySearch::IsVectorizable<T>) {
+			if (!std::is_constant_evaluated()) {
+				return ArrInt(ArraySearch::Count(data, size, element));
 			}
-			if (i == 0) {
-				reachedEnd = true;
+		}
+		ArrInt count = 0;
+		for (ArrInt i = 0; i < size; i++) {
+			if (element == data[i]) {
+				count++;
 			}
-			i--;
 		}
-		return nullptr;
+		return count;
+	}
+
+	/* Get the indices of every element equal to a given element, in ascending order.
+	@param element: Comparison value.
+	@returns Array of the matching indices. */
+	constexpr darray<ArrInt> FindAllIndices(const T& element) const
+	{
+		darray<ArrInt> indices;
+		if constexpr (ArraySearch::IsVectorizable<T>) {
+			if (!std::is_constant_evaluated()) {
+				ArraySearch::ForEachMatch(data, size, element, [&indices](size_t i) { indices.Add(ArrInt(i)); });
+				return indices;
+			}
+		}
+		for (ArrInt i = 0; i < size; i++) {
+			if (element == data[i]) {
+				indices.Add(i);
+			}
+		}
+		return indices;
 	}
 
 	/* Remove the nth instance of an element from the array. 
@@ -357,51 +909,137 @@ public:
 	@param occurrence (optional): nth occurrence of the element. */
 	constexpr void Remove(const T& element, ArrInt occurrence = 1, bool destructIfCan = true)
 	{
-		ArrInt occurrenceCount = 1;
-		for (ArrInt i = 0; i < size; i++) {
-			if (element == At(i)) {
-				if (occurrenceCount == occurrence) {
-					for (ArrInt j = (i); j < (size - 1); j++) {
-						data[j] = std::move(data[j + 1]);
-					}
-					size--;
-					return;
-				}
-				else {
-					occurrenceCount++;
-				}			
-			}
+		const ArrInt i = SearchFirst(element, occurrence);
+		if (i == size) {
+			return;
 		}
+		EraseAt(i);
 	}
 
-	/* Remove all occurrences of an element in the array. 
+	/* Remove all occurrences of an element in the array, in place without allocating.
 	Doesn't shrink array, but does decrement size if item is found.
 	@param element: Comparison value. 
 	@returns Amount of elements removed from the array. */
 	constexpr ArrInt RemoveAll(const T& element) 
 	{
-		ArrInt amount = 0;
-		ArrInt i = 0;
+		const ArrInt first = SearchFirst(element, 1);
+		if (first == size) {
+			return 0;
+		}
+
+		// The element may reference an element of this array, which gets moved over during compaction.
+		// Pointers to unrelated objects can't be compared in constant evaluation, so a copy is always made there.
+		if (std::is_constant_evaluated() || (&element >= data && &element < data + size)) {
+			const T copy = element;
+			return CompactFrom(first, [&copy](const T& e) { return copy == e; });
+		}
+		return CompactFrom(first, [&element](const T& e) { return element == e; });
+	}
 
-		T* newData = new T[capacity];
-		
-		for (int ind = 0; ind < size; ind++) {
-			if (data[ind] != element) {
-				newData[i] = std::move(data[ind]);
-				i++;
+	/* Remove all elements satisfying a predicate, in place without allocating. Maintains the order of the leftover elements.
+	@param shouldRemove: Callable taking a const T& and returning true if the element should be removed.
+	@returns Amount of elements removed from the array. */
+	template<typename Predicate>
+	constexpr ArrInt RemoveIf(Predicate&& shouldRemove) 
+	{
+		for (ArrInt i = 0; i < size; i++) {
+			if (shouldRemove(data[i])) {
+				return CompactFrom(i, shouldRemove);
 			}
-			else {
-				amount++;
+		}
+		return 0;
+	}
+
+	/* Remove an element at a specified index by moving the last element into it's place. O(1), but doesn't maintain order.
+	@param index: Index to remove.
+	@param outElement (optional): Pointer to element type to move the removed element to. */
+	constexpr void SwapRemoveAt(ArrInt index, T* outElement = nullptr) 
+	{
+		if (index >= size) {
+			return;
+		}
+
+		if (outElement) {
+			*outElement = std::move(data[index]);
+		}
+
+		size--;
+		if (index != size) {
+			data[index] = std::move(data[size]);
+		}
+		std::destroy_at(data + size);
+	}
+
+	/* Remove the nth instance of an element from the array by moving the last element into it's place. O(1) after finding, but doesn't maintain order.
+	@param element: Comparison value. 
+	@param occurrence (optional): nth occurrence of the element.
+	@returns If an element was removed. */
+	constexpr bool SwapRemove(const T& element, ArrInt occurrence = 1) 
+	{
+		const ArrInt i = SearchFirst(element, occurrence);
+		if (i == size) {
+			return false;
+		}
+		SwapRemoveAt(i);
+		return true;
+	}
+
+	/* Remove many elements by index at once, maintaining the order of the leftover elements. Each leftover element is moved at most once.
+	Duplicate and out of bounds indices are ignored.
+	@param sortedIndices: Pointer to indices to remove, in ascending order.
+	@param count: Amount of indices.
+	@returns Amount of elements removed from the array. */
+	constexpr ArrInt RemoveIndices(const ArrInt* sortedIndices, ArrInt count) 
+	{
+		ArrInt write = size;
+		ArrInt read = size;
+		for (ArrInt i = 0; i < count; i++) {
+			const ArrInt index = sortedIndices[i];
+			if (index >= size) {
+				break;
+			}
+			if (write == size) {
+				write = index;
+			}
+			else if (index < read) {
+				continue;
 			}
+			for (; read < index; read++, write++) {
+				data[write] = std::move(data[read]);
+			}
+			read = index + 1;
 		}
-		
-		delete[] data;
-		data = newData;
-		size = i;
 
+		if (write == size) {
+			return 0;
+		}
+
+		for (; read < size; read++, write++) {
+			data[write] = std::move(data[read]);
+		}
+		const ArrInt amount = size - write;
+		DestroyElements(data + write, amount);
+		size = write;
 		return amount;
 	}
 
+	/* See RemoveIndices(const ArrInt*, ArrInt). */
+	constexpr ArrInt RemoveIndices(const darray<ArrInt>& sortedIndices) 
+	{
+		return RemoveIndices(sortedIndices.GetData(), sortedIndices.Size());
+	}
+
+	/* Remove every element from an index onward in a single step, keeping the capacity. Does nothing if newSize isn't less than the size.
+	@param newSize: Amount of elements to keep. */
+	constexpr void Truncate(ArrInt newSize)
+	{
+		if (newSize >= size) {
+			return;
+		}
+		DestroyElements(data + newSize, size - newSize);
+		size = newSize;
+	}
+
 	/* Shrinks the array to the smallest possible size to store all elements. */
 	constexpr void Shrink() 
 	{
@@ -418,13 +1056,14 @@ public:
 			return;
 		}
 
-		if (size + 1 >= capacity) {
+		if (size == capacity) {
 			IncreaseCapacityFromAllocator();
 		}
 
+		std::construct_at(data + size, std::move(data[size - 1]));
 		size++;
 
-		for (ArrInt i = size - 1; i > index; i--) {
+		for (ArrInt i = size - 2; i > index; i--) {
 			data[i] = std::move(data[i - 1]);
 		}
 
@@ -433,7 +1072,7 @@ public:
 
 	/* Remove an element at a specified index, shifting all elements after it over by 1.
 	@param index: Index to remove.
-	@param outElement (optional): Pointer to element type to copy the removed element to. */
+	@param outElement (optional): Pointer to element type to move the removed element to. */
 	constexpr void RemoveAt(ArrInt index, T* outElement = nullptr) 
 	{
 		if (index >= size) {
@@ -441,34 +1080,84 @@ public:
 		}
 
 		if (outElement) {
-			*outElement = At(index);
+			*outElement = std::move(data[index]);
 		}
 
-		for (ArrInt i = index; i < size - 1; i++) {
-			data[i] = std::move(data[i + 1]);
-		}
-		size--;
+		EraseAt(index);
 	}
 
-	/* Set this array equal to another. */
-	constexpr void operator = (const darray<T, capacityInc> other)
+	/* Set this array equal to another, copying it's elements. Reuses the current data block if it has enough capacity. */
+	constexpr void operator = (const darray<T, capacityInc, Allocator>& other)
 	{
-		if (data)
-			delete[] data;
+		if (this == &other) {
+			return;
+		}
 
-		capacity = other.capacity;
+		DestroyElements(data, size);
+		size = 0;
+		if (other.size > capacity) {
+			FreeData(data, capacity);
+			capacity = other.capacity;
+			data = AllocateData(capacity);
+		}
+
+		CopyConstructElements(data, other.data, other.size);
+		stats.BytesCopied(sizeof(T) * other.size);
 		size = other.size;
-		data = new T[capacity];
+	}
 
-		for (ArrInt i = 0; i < size; i++) {
-			data[i] = other.data[i];
+	/* Set this array equal to another, taking ownership of it's data block. The other array is left empty with a capacity of 0. */
+	constexpr void operator = (darray<T, capacityInc, Allocator>&& other) noexcept
+	{
+		if (this == &other) {
+			return;
+		}
+
+		DestroyElements(data, size);
+		FreeData(data, capacity);
+		data = nullptr;
+		size = 0;
+		capacity = 0;
+
+		allocator = std::move(other.allocator);
+		TakeFrom(other);
+	}
+
+	/* Set this array equal to another using a different capacity increase function or allocator, such as small_darray.
+	Takes the other array's data block if this allocator is able to free it, otherwise moves the elements. */
+	template<darray_cap_inc otherCapacityInc, typename OtherAllocator>
+	constexpr void operator = (darray<T, otherCapacityInc, OtherAllocator>&& other)
+	{
+		DestroyElements(data, size);
+		FreeData(data, capacity);
+		data = nullptr;
+		size = 0;
+		capacity = 0;
+
+		TakeFrom(other);
+	}
+
+	/* Exchange the contents of this array with another. Never allocates or copies elements,
+	unless one of the arrays stores it's elements inline, in which case they are moved. */
+	constexpr void Swap(darray<T, capacityInc, Allocator>& other) noexcept
+	{
+		if (IsDataInline() || other.IsDataInline()) {
+			darray<T, capacityInc, Allocator> temp = std::move(other);
+			other = std::move(*this);
+			*this = std::move(temp);
+			return;
 		}
+
+		std::swap(data, other.data);
+		std::swap(size, other.size);
+		std::swap(capacity, other.capacity);
+		std::swap(allocator, other.allocator);
 	}
 
 	/* Concatenate two arrays into a new one. */
-	constexpr friend darray<T> operator + (const darray<T, capacityInc>& left, const darray<T, capacityInc>& right)
+	constexpr friend darray<T, capacityInc, Allocator> operator + (const darray<T, capacityInc, Allocator>& left, const darray<T, capacityInc, Allocator>& right)
 	{
-		darray<T> arr;
+		darray<T, capacityInc, Allocator> arr(left.allocator);
 		arr.Reserve(left.Size() + right.Size());
 		arr.InsertElements(left.data, left.Size());
 		arr.InsertElements(right.data, right.Size());
@@ -481,13 +1170,12 @@ public:
 	@return If the index was successfully found.*/
 	constexpr bool TryGetIndex(const T& element, ArrInt& outIndex) 
 	{
-		for (ArrInt i = 0; i < Size(); i++) {
-			if (At(i) == element) {
-				outIndex = i;
-				return true;
-			}
+		const ArrInt i = SearchFirst(element, 1);
+		if (i == size) {
+			return false;
 		}
-		return false;
+		outIndex = i;
+		return true;
 	}
 
 	/* Fill the array starting at the current size, until the max capacity, with a specific element. */
@@ -498,9 +1186,22 @@ public:
 		}
 	}
 
+	/* Get the allocations, reallocations and copied bytes of this array. All zeros unless CONTAINER_STATS is enabled.
+	Copies and moves of an array start with their own zeroed stats. */
+	constexpr ContainerStats GetStats() const
+	{
+		return stats.Get();
+	}
+
 	/* DANGEROUS!!!!! */
 	constexpr T* GetData() 
 	{
 		return data;
 	}
+
+	/* DANGEROUS!!!!! */
+	constexpr const T* GetData() const
+	{
+		return data;
+	}
 };
\ No newline at end of file
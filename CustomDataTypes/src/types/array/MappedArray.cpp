@@ -0,0 +1,159 @@
+#include "MappedArray.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <types/test/UnitTest.h>
+
+#if RUNTIME_UNIT_TESTS == true
+namespace MappedArrayRuntimeUnitTests
+{
+	struct Point
+	{
+		int x;
+		int y;
+	};
+
+	/* Path of a temporary file for a test, removing anything left over from an earlier run. */
+	static std::string TempPath(const char* name)
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / name).string();
+		std::remove(path.c_str());
+		return path;
+	}
+
+	/* Overwrite the start of a file with raw bytes. */
+	static void WriteBytes(const std::string& path, const void* bytes, size_t size, long offset)
+	{
+		FILE* file = fopen(path.c_str(), "r+b");
+		RUNTIME_TEST_ASSERT(file != nullptr);
+		fseek(file, offset, SEEK_SET);
+		fwrite(bytes, 1, size, file);
+		fclose(file);
+	}
+
+	/* Elements added before closing, across several growths, are read back after reopening. */
+	static void MappedArrayPersistTests()
+	{
+		const std::string path = TempPath("mapped_darray_persist.bin");
+		{
+			mapped_darray<Point> arr;
+			RUNTIME_TEST_ASSERT(arr.Open(path.c_str()));
+			RUNTIME_TEST_ASSERT(arr.IsOpen() && !arr.IsReadOnly());
+			RUNTIME_TEST_ASSERT(arr.Size() == 0);
+			for (int i = 0; i < 1000; i++) {
+				arr.Add(Point{ i, -i });
+			}
+			const Point extra[] = { { 5000, 1 }, { 5001, 2 } };
+			arr.InsertElements(extra, 2);
+			// Inserting from the array itself while it grows.
+			arr.Shrink();
+			arr.InsertElements(arr.GetData(), 3);
+			RUNTIME_TEST_ASSERT(arr.Size() == 1005);
+			RUNTIME_TEST_ASSERT(arr.Capacity() >= arr.Size());
+			RUNTIME_TEST_ASSERT(arr.Flush());
+			arr.Close();
+			RUNTIME_TEST_ASSERT(!arr.IsOpen() && arr.Size() == 0 && arr.GetData() == nullptr);
+		}
+
+		mapped_darray<Point> arr;
+		RUNTIME_TEST_ASSERT(arr.Open(path.c_str()));
+		RUNTIME_TEST_ASSERT(arr.Size() == 1005);
+		bool matches = true;
+		for (int i = 0; i < 1000; i++) {
+			matches &= arr[i].x == i && arr[i].y == -i;
+		}
+		RUNTIME_TEST_ASSERT(matches);
+		RUNTIME_TEST_ASSERT(arr[1000].x == 5000 && arr[1001].x == 5001 && arr[1001].y == 2);
+		RUNTIME_TEST_ASSERT(arr[1002].x == 0 && arr[1003].x == 1 && arr[1004].x == 2);
+
+		// Reopened arrays keep growing from where they were.
+		arr.Add(Point{ 7, 7 });
+		RUNTIME_TEST_ASSERT(arr.Size() == 1006 && arr[1005].x == 7);
+		arr.Clear();
+		RUNTIME_TEST_ASSERT(arr.Size() == 0 && arr.Capacity() > 0);
+		arr.Close();
+
+		mapped_darray<Point> cleared;
+		RUNTIME_TEST_ASSERT(cleared.Open(path.c_str()));
+		RUNTIME_TEST_ASSERT(cleared.Size() == 0);
+		cleared.Close();
+		std::remove(path.c_str());
+	}
+
+	/* Read only arrays see the stored elements, and don't create missing files. */
+	static void MappedArrayReadOnlyTests()
+	{
+		const std::string path = TempPath("mapped_darray_read_only.bin");
+		mapped_darray<int> missing;
+		RUNTIME_TEST_ASSERT(!missing.Open(path.c_str(), true));
+		RUNTIME_TEST_ASSERT(!missing.IsOpen());
+
+		{
+			mapped_darray<int> arr;
+			RUNTIME_TEST_ASSERT(arr.Open(path.c_str()));
+			arr.InsertElements({ 3, 1, 4, 1, 5 });
+			arr.Close();
+		}
+
+		mapped_darray<int> arr;
+		RUNTIME_TEST_ASSERT(arr.Open(path.c_str(), true));
+		RUNTIME_TEST_ASSERT(arr.IsOpen() && arr.IsReadOnly());
+		RUNTIME_TEST_ASSERT(arr.Size() == 5);
+		int sum = 0;
+		for (const int value : arr) {
+			sum += value;
+		}
+		RUNTIME_TEST_ASSERT(sum == 14 && arr[2] == 4);
+
+		// Moving keeps the mapping, leaving the source closed.
+		mapped_darray<int> moved = std::move(arr);
+		RUNTIME_TEST_ASSERT(!arr.IsOpen());
+		RUNTIME_TEST_ASSERT(moved.IsReadOnly() && moved.Size() == 5 && moved[4] == 5);
+		moved.Close();
+		std::remove(path.c_str());
+	}
+
+	/* Files that aren't a mapped_darray of the same element size are refused, and left untouched. */
+	static void MappedArrayRejectTests()
+	{
+		const std::string path = TempPath("mapped_darray_reject.bin");
+		{
+			mapped_darray<int> arr;
+			RUNTIME_TEST_ASSERT(arr.Open(path.c_str()));
+			arr.InsertElements({ 1, 2, 3 });
+			arr.Close();
+		}
+
+		// Different element size.
+		mapped_darray<long long> wide;
+		RUNTIME_TEST_ASSERT(!wide.Open(path.c_str()));
+		RUNTIME_TEST_ASSERT(!wide.IsOpen());
+		mapped_darray<char> narrow;
+		RUNTIME_TEST_ASSERT(!narrow.Open(path.c_str(), true));
+
+		// The refused opens didn't change the file.
+		mapped_darray<int> arr;
+		RUNTIME_TEST_ASSERT(arr.Open(path.c_str()));
+		RUNTIME_TEST_ASSERT(arr.Size() == 3 && arr[2] == 3);
+		arr.Close();
+
+		// Wrong magic.
+		const uint64_t badMagic = MAPPED_DARRAY_MAGIC ^ 1;
+		WriteBytes(path, &badMagic, sizeof(badMagic), 0);
+		RUNTIME_TEST_ASSERT(!arr.Open(path.c_str()));
+		RUNTIME_TEST_ASSERT(!arr.Open(path.c_str(), true));
+		std::remove(path.c_str());
+
+		// Files too short to hold a header.
+		FILE* file = fopen(path.c_str(), "wb");
+		RUNTIME_TEST_ASSERT(file != nullptr);
+		fwrite("DARRAY", 1, 6, file);
+		fclose(file);
+		RUNTIME_TEST_ASSERT(!arr.Open(path.c_str()));
+		std::remove(path.c_str());
+	}
+	RUNTIME_TEST_SUITE(MappedArrayPersistTests);
+	RUNTIME_TEST_SUITE(MappedArrayReadOnlyTests);
+	RUNTIME_TEST_SUITE(MappedArrayRejectTests);
+}
+#endif
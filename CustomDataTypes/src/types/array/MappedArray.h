@@ -0,0 +1,283 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <types/array/DynamicArray.h>
+#include <types/file/MappedFile.h>
+
+/* Bytes reserved at the start of a mapped_darray file for it's header. Elements start right after, aligned to a cache line. */
+constexpr size_t MAPPED_DARRAY_HEADER_SIZE = 64;
+
+/* Identifies a file as a mapped_darray. The bytes read "DARRAY" followed by a format marker. */
+constexpr uint64_t MAPPED_DARRAY_MAGIC = 0x0001594152524144ULL;
+
+/* Format version of mapped_darray files. Files of a different version are refused by Open(). */
+constexpr uint32_t MAPPED_DARRAY_VERSION = 1;
+
+/*
+Dynamic array stored in a memory mapped file, so it persists between runs, and reopening it is only a mapping rather than a rebuild.
+The file holds a small header with the element count, followed by the raw elements, so only trivially copyable types are allowed,
+and files are only portable between machines with the same type layout and byte order.
+Growing resizes the file and remaps it, which may move the elements, invalidating pointers into the array.
+Optionally disable out of bounds checks for indexing by setting the ARRAY_CHECK_OUT_OF_BOUNDS macro to false. See darray.
+
+@param - T: Trivially copyable type the array contains
+@param - capacityInc (optional. default _ArrayCapacityIncrease): Pointer to a function that returns a new capacity from the current one for increasing.
+*/
+template<typename T, darray_cap_inc capacityInc = _ArrayCapacityIncrease>
+struct mapped_darray
+{
+	static_assert(std::is_trivially_copyable_v<T>, "mapped_darray can only store trivially copyable types, since elements are stored as raw bytes in a file");
+	static_assert(alignof(T) <= MAPPED_DARRAY_HEADER_SIZE, "mapped_darray element alignment can't exceed MAPPED_DARRAY_HEADER_SIZE");
+
+private:
+
+	/* Stored at the start of the file. */
+	struct Header
+	{
+		uint64_t magic;
+		uint32_t version;
+		uint32_t elementSize;
+		uint64_t count;
+	};
+
+	MappedFile file;
+
+	/* Display an error message and abort the program. */
+	static void ArrayError(const char* errorMessage)
+	{
+		_ArrayError(errorMessage);
+		abort();
+	}
+
+	Header* GetHeader() const
+	{
+		return static_cast<Header*>(file.Data());
+	}
+
+	T* Elements() const
+	{
+		return reinterpret_cast<T*>(static_cast<char*>(file.Data()) + MAPPED_DARRAY_HEADER_SIZE);
+	}
+
+	/* Amount of elements that fit in the file at it's current size. */
+	size_t FileCapacity() const
+	{
+		return (file.Size() - MAPPED_DARRAY_HEADER_SIZE) / sizeof(T);
+	}
+
+	/* Error if the array can't be modified. */
+	void CheckWritable(const char* errorMessage) const
+	{
+		if (!file.IsOpen() || file.IsReadOnly()) {
+			ArrayError(errorMessage);
+		}
+	}
+
+	/* Resize the file to hold a new capacity of elements. May move the elements. */
+	void Reallocate(ArrInt newCapacity)
+	{
+		if (newCapacity > (size_t(-1) - MAPPED_DARRAY_HEADER_SIZE) / sizeof(T)) {
+			ArrayError("Array capacity overflow from mapped_darray::Reallocate(). The file is too large for the address space.");
+		}
+		if (!file.Resize(MAPPED_DARRAY_HEADER_SIZE + size_t(newCapacity) * sizeof(T))) {
+			ArrayError("Failed to resize the file of a mapped_darray from mapped_darray::Reallocate().");
+		}
+		if (GetHeader()->count > newCapacity) {
+			GetHeader()->count = newCapacity;
+		}
+	}
+
+	/* Grow the file to fit an extra amount of elements, from the capacity increase function. */
+	void ReserveForAdding(ArrInt amount)
+	{
+		const ArrInt size = Size();
+		if (amount > ARRAY_MAX_CAPACITY - size) {
+			ArrayError("Array capacity overflow from mapped_darray::ReserveForAdding(). Too many elements for the array size type.");
+		}
+		const ArrInt required = size + amount;
+		if (required <= Capacity()) {
+			return;
+		}
+		ArrInt newCapacity = capacityInc(Capacity());
+		if (newCapacity < required) {
+			newCapacity = required;
+		}
+		Reallocate(newCapacity);
+	}
+
+public:
+
+	/* Construct a closed array. Call Open() before using it. */
+	mapped_darray() {}
+
+	mapped_darray(const mapped_darray&) = delete;
+	void operator = (const mapped_darray&) = delete;
+
+	/* Move constructor. Takes over the other array's file, leaving it closed. */
+	mapped_darray(mapped_darray&& other) noexcept = default;
+
+	/* Move assignment. Closes this array's file, and takes over the other array's file, leaving it closed. */
+	mapped_darray& operator = (mapped_darray&& other) noexcept = default;
+
+	/* Open a file and map it's elements. A new file is created with no elements if it doesn't exist, unless opening read only.
+	@param path: Path of the file.
+	@param readOnly (optional): Map the elements read only. Any modification errors.
+	@returns If the file was opened. False if it couldn't be opened, or is not a mapped_darray file of the same element size and version. */
+	bool Open(const char* path, bool readOnly = false)
+	{
+		if (!file.Open(path, readOnly)) {
+			return false;
+		}
+
+		if (file.Size() == 0 && !readOnly) {
+			if (!file.Resize(MAPPED_DARRAY_HEADER_SIZE)) {
+				file.Close();
+				return false;
+			}
+			Header* header = GetHeader();
+			header->magic = MAPPED_DARRAY_MAGIC;
+			header->version = MAPPED_DARRAY_VERSION;
+			header->elementSize = sizeof(T);
+			header->count = 0;
+		}
+
+		const Header* header = GetHeader();
+		if (file.Size() < MAPPED_DARRAY_HEADER_SIZE
+			|| header->magic != MAPPED_DARRAY_MAGIC
+			|| header->version != MAPPED_DARRAY_VERSION
+			|| header->elementSize != sizeof(T)
+			|| header->count > FileCapacity()
+			|| header->count > ARRAY_MAX_CAPACITY) {
+			file.Close();
+			return false;
+		}
+		return true;
+	}
+
+	/* Unmap and close the file. The contents are written to disk by the OS in the background. Call Flush() first to write them synchronously. */
+	void Close()
+	{
+		file.Close();
+	}
+
+	/* Synchronously write any modified elements to disk.
+	@returns If the flush succeeded. */
+	bool Flush()
+	{
+		return file.Flush();
+	}
+
+	bool IsOpen() const { return file.IsOpen(); }
+
+	bool IsReadOnly() const { return file.IsReadOnly(); }
+
+	/* Get size of array. 0 if not open. */
+	ArrInt Size() const { return file.IsOpen() ? ArrInt(GetHeader()->count) : 0; }
+
+	/* Get the amount of elements the file can hold without being resized. 0 if not open. */
+	ArrInt Capacity() const
+	{
+		if (!file.IsOpen()) {
+			return 0;
+		}
+		const size_t capacity = FileCapacity();
+		return capacity > ARRAY_MAX_CAPACITY ? ARRAY_MAX_CAPACITY : ArrInt(capacity);
+	}
+
+	T* begin() const { return file.IsOpen() ? Elements() : nullptr; }
+	T* end() const { return file.IsOpen() ? Elements() + Size() : nullptr; }
+
+	/* Get a reference to an element at a specific index. Will only check if correct index if ARRAY_CHECK_OUT_OF_BOUNDS macro is set.
+	Writing through the reference of a read only array is undefined.
+	@param index: Array index to check.
+	@returns Reference to the item in the array. */
+	T& At(ArrInt index) const
+	{
+		#if ARRAY_CHECK_OUT_OF_BOUNDS == true
+		if (index >= Size()) {
+			ArrayError("Index out of bounds from mapped_darray::At().");
+		}
+		#endif
+		return Elements()[index];
+	}
+
+	/* Index of operator. See At(). */
+	T& operator [] (ArrInt index) const
+	{
+		return At(index);
+	}
+
+	/* Grow the file to hold the supplied capacity IF the current capacity is less than the supplied. */
+	void Reserve(ArrInt newCapacity)
+	{
+		CheckWritable("Attempted to reserve capacity of a closed or read only mapped_darray.");
+		if (newCapacity > Capacity()) {
+			Reallocate(newCapacity);
+		}
+	}
+
+	/* Shrink the file to the smallest possible size to store all elements. */
+	void Shrink()
+	{
+		CheckWritable("Attempted to shrink a closed or read only mapped_darray.");
+		Reallocate(Size());
+	}
+
+	/* Add element to the end of the array. The value may reference an element in this array. */
+	void Add(const T& value)
+	{
+		CheckWritable("Attempted to add to a closed or read only mapped_darray.");
+		// Growing may move the mapping the value is in.
+		const T copy = value;
+		ReserveForAdding(1);
+		Header* header = GetHeader();
+		Elements()[header->count] = copy;
+		header->count++;
+	}
+
+	/* Insert N elements from an initializer list. Only performs one capacity increase.
+	@param il: Initializer list values. */
+	void InsertElements(const std::initializer_list<T>& il)
+	{
+		InsertElements(il.begin(), ArrInt(il.size()));
+	}
+
+	/* Insert N elements from a specified start element. Only performs one capacity increase.
+	The elements may be from this array.
+	@param start: Pointer to an array of T value(s).
+	@param amount: amount of T's to insert. */
+	void InsertElements(const T* start, ArrInt amount)
+	{
+		CheckWritable("Attempted to insert into a closed or read only mapped_darray.");
+		if (amount == 0) {
+			return;
+		}
+
+		// Growing may move the mapping the elements are in, so remember where in it they were.
+		const T* elements = Elements();
+		const bool fromThisArray = std::less_equal<const T*>()(elements, start) && std::less<const T*>()(start, elements + Size());
+		const ArrInt sourceIndex = fromThisArray ? ArrInt(start - elements) : 0;
+		ReserveForAdding(amount);
+		if (fromThisArray) {
+			start = Elements() + sourceIndex;
+		}
+
+		Header* header = GetHeader();
+		memcpy((void*)(Elements() + header->count), (const void*)start, sizeof(T) * amount);
+		header->count += amount;
+	}
+
+	/* Remove every element, keeping the file's capacity. */
+	void Clear()
+	{
+		CheckWritable("Attempted to clear a closed or read only mapped_darray.");
+		GetHeader()->count = 0;
+	}
+
+	/* Get a pointer to the first element. nullptr if not open. Invalidated by any growth. */
+	T* GetData() const
+	{
+		return begin();
+	}
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <types/array/DynamicArray.h>
+
+/* darray allocator policy with storage for N elements inline within itself.
+Requests of up to N elements are served from the inline storage, and larger ones spill to the global heap.
+Copying or moving the allocator never copies the inline storage. */
+template<typename T, size_t N>
+struct darray_inline_allocator
+{
+	static_assert(N > 0, "darray_inline_allocator must have an inline capacity greater than 0");
+
+	static constexpr size_t INITIAL_CAPACITY = N;
+
+	static constexpr bool USES_GLOBAL_HEAP = true;
+
+	darray_inline_allocator() {}
+
+	/* The inline storage belongs to each instance, so nothing is copied. */
+	darray_inline_allocator(const darray_inline_allocator&) {}
+
+	/* The inline storage belongs to each instance, so nothing is copied. */
+	darray_inline_allocator& operator = (const darray_inline_allocator&) { return *this; }
+
+	/* Get uninitialized storage for count elements. The inline storage is used if count fits. */
+	T* Allocate(size_t count)
+	{
+		if (count <= N) {
+			return InlineData();
+		}
+		return std::allocator<T>().allocate(count);
+	}
+
+	/* Free storage from Allocate(). Freeing the inline storage is a no-op. */
+	void Free(T* block, size_t count)
+	{
+		if (!IsInline(block)) {
+			std::allocator<T>().deallocate(block, count);
+		}
+	}
+
+	/* The inline storage can be resized to anything up to N without moving. */
+	bool TryResizeInPlace(T* block, size_t /*oldCount*/, size_t newCount)
+	{
+		return IsInline(block) && newCount <= N;
+	}
+
+	/* Whether a block is the inline storage. */
+	bool IsInline(const T* block) const
+	{
+		return block == reinterpret_cast<const T*>(storage);
+	}
+
+private:
+
+	T* InlineData()
+	{
+		return reinterpret_cast<T*>(storage);
+	}
+
+	alignas(T) unsigned char storage[N * sizeof(T)];
+};
+
+/*
+Dynamic array storing up to N elements inline, only allocating from the heap once it grows past N.
+Has the full darray API, and converts to and from darray<T> by moving. Converting a small_darray that has
+spilled to the heap into a darray (or back) hands over the heap block without copying.
+
+@param - T: Type the array contains
+@param - N: Amount of elements stored inline.
+@param - capacityInc (optional. default _ArrayCapacityIncrease): Pointer to a function that returns a new capacity from the current one for increasing.
+*/
+template<typename T, size_t N, darray_cap_inc capacityInc = _ArrayCapacityIncrease>
+using small_darray = darray<T, capacityInc, darray_inline_allocator<T, N>>;
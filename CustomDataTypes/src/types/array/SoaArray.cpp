@@ -0,0 +1,131 @@
+#include "SoaArray.h"
+#include <cstdint>
+#include <string>
+#include <types/test/UnitTest.h>
+
+#if RUNTIME_UNIT_TESTS == true
+namespace SoaArrayRuntimeUnitTests
+{
+	typedef darray_soa<int, std::string, char, double> Table;
+
+	/* Heap allocated strings, so lost or doubly destroyed elements show up as leaks or double frees. */
+	static std::string Name(int i)
+	{
+		return std::string(32, char('a' + i % 26)) + std::to_string(i);
+	}
+
+	/* Whether row i holds the values added for i. */
+	static bool RowMatches(Table& table, ArrInt row, int i)
+	{
+		auto [id, name, letter, weight] = table[row];
+		return id == i && name == Name(i) && letter == char('a' + i % 26) && weight == i * 0.5;
+	}
+
+	static Table MakeTable(int rows)
+	{
+		Table table;
+		for (int i = 0; i < rows; i++) {
+			table.Add(i, Name(i), char('a' + i % 26), i * 0.5);
+		}
+		return table;
+	}
+
+	/* Every column starts on SOA_COLUMN_ALIGNMENT, in column order without overlapping, after every growth. */
+	static bool ColumnsAligned(const Table& table)
+	{
+		const uintptr_t starts[] = {
+			reinterpret_cast<uintptr_t>(table.Column<0>()), reinterpret_cast<uintptr_t>(table.Column<1>()),
+			reinterpret_cast<uintptr_t>(table.Column<2>()), reinterpret_cast<uintptr_t>(table.Column<3>())
+		};
+		const size_t sizes[] = { sizeof(int), sizeof(std::string), sizeof(char), sizeof(double) };
+		for (size_t i = 0; i < 4; i++) {
+			if (starts[i] % SOA_COLUMN_ALIGNMENT != 0) return false;
+			if (i > 0 && starts[i] < starts[i - 1] + sizes[i - 1] * table.Capacity()) return false;
+		}
+		return true;
+	}
+
+	/* Rows added one at a time grow every column together, keeping every value. */
+	static void SoaAddGrowthTests()
+	{
+		Table table;
+		RUNTIME_TEST_ASSERT(table.Size() == 0 && table.Capacity() == 0 && table.Column<1>() == nullptr);
+		ArrInt lastCapacity = 0;
+		int growths = 0;
+		for (int i = 0; i < 200; i++) {
+			table.Add(i, Name(i), char('a' + i % 26), i * 0.5);
+			if (table.Capacity() != lastCapacity) {
+				lastCapacity = table.Capacity();
+				growths++;
+				RUNTIME_TEST_ASSERT(ColumnsAligned(table));
+			}
+		}
+		RUNTIME_TEST_ASSERT(growths > 1 && table.Size() == 200);
+		for (int i = 0; i < 200; i++) {
+			RUNTIME_TEST_ASSERT(RowMatches(table, ArrInt(i), i));
+			RUNTIME_TEST_ASSERT(table.Column<1>()[i] == Name(i) && table.At<0>(ArrInt(i)) == i);
+		}
+
+		// Values referencing the array's own elements survive the reallocation they trigger.
+		Table self;
+		self.Add(0, Name(0), 'a', 0.0);
+		while (self.Size() < 64) {
+			self.Add(self.At<0>(0), self.At<1>(0), self.At<2>(0), self.At<3>(0));
+		}
+		RUNTIME_TEST_ASSERT(self.Column<1>()[63] == Name(0));
+
+		table.Shrink();
+		RUNTIME_TEST_ASSERT(table.Capacity() == 200 && ColumnsAligned(table) && RowMatches(table, 199, 199));
+	}
+	RUNTIME_TEST_SUITE(SoaAddGrowthTests);
+
+	/* RemoveAt keeps the order of the rows after it, and SwapRemoveAt moves the last row into the gap. Out of range indices do nothing. */
+	static void SoaRemoveTests()
+	{
+		Table table = MakeTable(10);
+		table.RemoveAt(3);
+		table.RemoveAt(8);
+		table.RemoveAt(100);
+		RUNTIME_TEST_ASSERT(table.Size() == 8);
+		const int afterRemove[] = { 0, 1, 2, 4, 5, 6, 7, 8 };
+		for (ArrInt i = 0; i < 8; i++) {
+			RUNTIME_TEST_ASSERT(RowMatches(table, i, afterRemove[i]));
+		}
+
+		table.SwapRemoveAt(1);
+		table.SwapRemoveAt(table.Size() - 1);
+		table.SwapRemoveAt(100);
+		RUNTIME_TEST_ASSERT(table.Size() == 6);
+		const int afterSwapRemove[] = { 0, 8, 2, 4, 5, 6 };
+		for (ArrInt i = 0; i < 6; i++) {
+			RUNTIME_TEST_ASSERT(RowMatches(table, i, afterSwapRemove[i]));
+		}
+
+		table.Clear();
+		RUNTIME_TEST_ASSERT(table.Size() == 0 && table.Capacity() > 0);
+		table.Add(7, Name(7), char('a' + 7), 3.5);
+		RUNTIME_TEST_ASSERT(RowMatches(table, 0, 7));
+	}
+	RUNTIME_TEST_SUITE(SoaRemoveTests);
+
+	/* Copies own their own strings, and moves hand over the data block, leaving the source empty. */
+	static void SoaCopyMoveTests()
+	{
+		Table table = MakeTable(20);
+		Table copy = table;
+		RUNTIME_TEST_ASSERT(copy.Size() == 20 && copy.Column<1>() != table.Column<1>() && ColumnsAligned(copy));
+		copy.At<1>(5) = "changed";
+		RUNTIME_TEST_ASSERT(RowMatches(table, 5, 5) && copy.At<1>(5) == "changed");
+
+		const std::string* strings = table.Column<1>();
+		Table moved = std::move(table);
+		RUNTIME_TEST_ASSERT(moved.Column<1>() == strings && moved.Size() == 20 && table.Size() == 0 && table.Capacity() == 0);
+
+		copy = moved;
+		RUNTIME_TEST_ASSERT(copy.Size() == 20 && RowMatches(copy, 5, 5));
+		copy.Swap(table);
+		RUNTIME_TEST_ASSERT(copy.Size() == 0 && table.Size() == 20 && RowMatches(table, 19, 19));
+	}
+	RUNTIME_TEST_SUITE(SoaCopyMoveTests);
+}
+#endif
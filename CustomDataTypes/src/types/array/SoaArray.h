@@ -0,0 +1,342 @@
+#pragma once
+
+#include <new>
+#include <tuple>
+#include <types/array/DynamicArray.h>
+
+/* Alignment of every column within a darray_soa's data block. A full cache line, so every column starts on one
+and can be loaded with aligned vector instructions. */
+constexpr size_t SOA_COLUMN_ALIGNMENT = 64;
+
+/*
+Structure of arrays. Stores each field in it's own contiguous column, so loops touching only some of the fields
+don't pull the rest into cache. All columns share a single size and capacity, and live in one data block
+that is grown in one step.
+Optionally disable out of bounds checks for indexing by setting the ARRAY_CHECK_OUT_OF_BOUNDS macro to false. See darray.
+
+@param - Ts: Type of each column, in order.
+*/
+template<typename... Ts>
+struct darray_soa
+{
+	static_assert(sizeof...(Ts) > 0, "darray_soa must have at least one column");
+
+	/* Amount of columns. */
+	static constexpr size_t COLUMN_COUNT = sizeof...(Ts);
+
+	/* Type of the column at index I. */
+	template<size_t I>
+	using ColumnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+private:
+
+	/* Pointer to the start of each column. The first column is at the start of the data block. */
+	std::tuple<Ts*...> columns;
+
+	/* The amount of elements currently stored in each column. */
+	ArrInt size;
+
+	/* The amount of elements each column can hold without reallocation. */
+	ArrInt capacity;
+
+	/* Display an error message and abort the program. */
+	static void ArrayError(const char* errorMessage)
+	{
+		_ArrayError(errorMessage);
+		abort();
+	}
+
+	/* Call func with the index sequence of the columns, so it can expand over every column. */
+	template<typename Func>
+	static void ForEachColumnIndex(Func&& func)
+	{
+		func(std::index_sequence_for<Ts...>{});
+	}
+
+	/* Byte size of a data block holding a capacity of elements in every column, with each column aligned to SOA_COLUMN_ALIGNMENT.
+	Errors if it doesn't fit in a size_t. */
+	static size_t BlockBytes(ArrInt blockCapacity)
+	{
+		size_t bytes = 0;
+		((bytes = ColumnEnd<Ts>(bytes, blockCapacity)), ...);
+		return bytes;
+	}
+
+	/* End offset of a column starting at the first aligned offset after start. */
+	template<typename T>
+	static size_t ColumnEnd(size_t start, ArrInt blockCapacity)
+	{
+		const size_t aligned = (start + SOA_COLUMN_ALIGNMENT - 1) & ~(SOA_COLUMN_ALIGNMENT - 1);
+		if (aligned < start || (size_t(-1) - aligned) / sizeof(T) < blockCapacity) {
+			ArrayError("Array capacity overflow from darray_soa::BlockBytes(). The data block is too large for the address space.");
+		}
+		return aligned + sizeof(T) * blockCapacity;
+	}
+
+	/* Allocate a data block of uninitialized columns. A capacity of 0 allocates nothing. */
+	static std::tuple<Ts*...> AllocateColumns(ArrInt blockCapacity)
+	{
+		std::tuple<Ts*...> block;
+		if (blockCapacity == 0) {
+			ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+				((std::get<I>(block) = nullptr), ...);
+			});
+			return block;
+		}
+
+		unsigned char* bytes = static_cast<unsigned char*>(::operator new(BlockBytes(blockCapacity), std::align_val_t(SOA_COLUMN_ALIGNMENT)));
+		size_t offset = 0;
+		ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+			((offset = (offset + SOA_COLUMN_ALIGNMENT - 1) & ~(SOA_COLUMN_ALIGNMENT - 1),
+				std::get<I>(block) = reinterpret_cast<ColumnType<I>*>(bytes + offset),
+				offset += sizeof(ColumnType<I>) * blockCapacity), ...);
+		});
+		return block;
+	}
+
+	/* Free a data block from AllocateColumns(). Does not call any destructors. */
+	static void FreeColumns(std::tuple<Ts*...>& block)
+	{
+		if (std::get<0>(block)) {
+			::operator delete(static_cast<void*>(std::get<0>(block)), std::align_val_t(SOA_COLUMN_ALIGNMENT));
+		}
+	}
+
+	/* Call the destructors of every stored element. */
+	void DestroyElements()
+	{
+		ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+			(darray<ColumnType<I>>::DestroyElements(std::get<I>(columns), size), ...);
+		});
+	}
+
+	/* Move the stored elements into a new data block, and free the old one. */
+	void RelocateInto(std::tuple<Ts*...>& newColumns, ArrInt newCapacity)
+	{
+		ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+			(darray<ColumnType<I>>::RelocateElements(std::get<I>(newColumns), std::get<I>(columns), size), ...);
+		});
+		FreeColumns(columns);
+		columns = newColumns;
+		capacity = newCapacity;
+	}
+
+	/* Get the next capacity from the capacity increase function. Errors if the capacity can't grow any further. */
+	ArrInt NextCapacity() const
+	{
+		const ArrInt newCapacity = _ArrayCapacityIncrease(capacity);
+		if (newCapacity <= capacity) {
+			ArrayError("Array capacity overflow from darray_soa::NextCapacity(). The capacity increase function did not increase the capacity.");
+		}
+		return newCapacity;
+	}
+
+	/* Take the other array's data block, leaving it empty with a capacity of 0. */
+	void TakeFrom(darray_soa& other)
+	{
+		columns = other.columns;
+		size = other.size;
+		capacity = other.capacity;
+		other.columns = AllocateColumns(0);
+		other.size = 0;
+		other.capacity = 0;
+	}
+
+	/* Copy construct every element of another array into this array's uninitialized columns. */
+	void CopyElementsFrom(const darray_soa& other)
+	{
+		ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+			(darray<ColumnType<I>>::CopyConstructElements(std::get<I>(columns), std::get<I>(other.columns), other.size), ...);
+		});
+		size = other.size;
+	}
+
+	/* Error if an index is past the last row. Only checks if the ARRAY_CHECK_OUT_OF_BOUNDS macro is set. */
+	void CheckIndex(ArrInt index, const char* errorMessage) const
+	{
+		#if ARRAY_CHECK_OUT_OF_BOUNDS == true
+		if (index >= size) {
+			ArrayError(errorMessage);
+		}
+		#endif
+	}
+
+public:
+
+	/* Default constructor. Does not allocate until the first element is added. */
+	darray_soa()
+	{
+		columns = AllocateColumns(0);
+		size = 0;
+		capacity = 0;
+	}
+
+	/* Copy constructor */
+	darray_soa(const darray_soa& other)
+	{
+		columns = AllocateColumns(other.size);
+		capacity = other.size;
+		CopyElementsFrom(other);
+	}
+
+	/* Move constructor. Takes ownership of the other array's data block. The other array is left empty with a capacity of 0. */
+	darray_soa(darray_soa&& other) noexcept
+	{
+		TakeFrom(other);
+	}
+
+	/* Destructor. Calls the destructors of all the stored elements, then frees the data block. */
+	~darray_soa()
+	{
+		DestroyElements();
+		FreeColumns(columns);
+	}
+
+	/* Copy assignment. Reuses the current data block if it can hold every element of the other array. */
+	void operator = (const darray_soa& other)
+	{
+		if (this == &other) {
+			return;
+		}
+		DestroyElements();
+		size = 0;
+		if (capacity < other.size) {
+			FreeColumns(columns);
+			columns = AllocateColumns(other.size);
+			capacity = other.size;
+		}
+		CopyElementsFrom(other);
+	}
+
+	/* Move assignment. Frees this array's elements and takes the other array's data block. */
+	void operator = (darray_soa&& other) noexcept
+	{
+		if (this == &other) {
+			return;
+		}
+		DestroyElements();
+		FreeColumns(columns);
+		TakeFrom(other);
+	}
+
+	/* Swap the contents of two arrays without copying any elements. */
+	void Swap(darray_soa& other) noexcept
+	{
+		std::swap(columns, other.columns);
+		std::swap(size, other.size);
+		std::swap(capacity, other.capacity);
+	}
+
+	/* Get size of array. Every column holds this many elements. */
+	inline ArrInt Size() const { return size; }
+
+	/* Get the current capacity of every column. */
+	inline ArrInt Capacity() const { return capacity; }
+
+	/* Get a pointer to the first element of a column. Each column is aligned to SOA_COLUMN_ALIGNMENT.
+	@param I: Column index. */
+	template<size_t I>
+	ColumnType<I>* Column() { return std::get<I>(columns); }
+
+	/* Get a pointer to the first element of a column. Each column is aligned to SOA_COLUMN_ALIGNMENT.
+	@param I: Column index. */
+	template<size_t I>
+	const ColumnType<I>* Column() const { return std::get<I>(columns); }
+
+	/* Get a reference to an element of a column. Will only check if correct index if ARRAY_CHECK_OUT_OF_BOUNDS macro is set.
+	@param I: Column index.
+	@param index: Row index. */
+	template<size_t I>
+	ColumnType<I>& At(ArrInt index)
+	{
+		CheckIndex(index, "Index out of bounds from darray_soa::At().");
+		return std::get<I>(columns)[index];
+	}
+
+	/* Get references to every column's element at an index. Will only check if correct index if ARRAY_CHECK_OUT_OF_BOUNDS macro is set.
+	@param index: Row index.
+	@returns Tuple of references, usable with structured bindings. */
+	std::tuple<Ts&...> operator [] (ArrInt index)
+	{
+		CheckIndex(index, "Index out of bounds from darray_soa::operator[].");
+		return std::apply([&](Ts*... column) { return std::tuple<Ts&...>(column[index]...); }, columns);
+	}
+
+	/* Increase the capacity of every column to the supplied value IF the current capacity is less than the supplied. */
+	void Reserve(ArrInt newCapacity)
+	{
+		if (newCapacity > capacity) {
+			std::tuple<Ts*...> newColumns = AllocateColumns(newCapacity);
+			RelocateInto(newColumns, newCapacity);
+		}
+	}
+
+	/* Shrinks every column to the smallest possible size to store all elements. */
+	void Shrink()
+	{
+		if (size < capacity) {
+			std::tuple<Ts*...> newColumns = AllocateColumns(size);
+			RelocateInto(newColumns, size);
+		}
+	}
+
+	/* Add a row to the end of the array, with one value per column. Every column grows in the same reallocation.
+	The values may reference elements in this array.
+	@param values: Value of each column, in column order. */
+	template<typename... Args>
+		requires (sizeof...(Args) == sizeof...(Ts))
+	void Add(Args&&... values)
+	{
+		if (size < capacity) {
+			ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+				(std::construct_at(std::get<I>(columns) + size, std::forward<Args>(values)), ...);
+			});
+			size++;
+			return;
+		}
+
+		// The new row is constructed before the old block is freed, so the values may reference elements in it.
+		const ArrInt newCapacity = NextCapacity();
+		std::tuple<Ts*...> newColumns = AllocateColumns(newCapacity);
+		ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+			(std::construct_at(std::get<I>(newColumns) + size, std::forward<Args>(values)), ...);
+		});
+		RelocateInto(newColumns, newCapacity);
+		size++;
+	}
+
+	/* Remove the row at a specified index from every column, shifting all rows after it over by 1.
+	@param index: Index to remove. */
+	void RemoveAt(ArrInt index)
+	{
+		if (index >= size) {
+			return;
+		}
+		ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+			((std::move(std::get<I>(columns) + index + 1, std::get<I>(columns) + size, std::get<I>(columns) + index),
+				std::destroy_at(std::get<I>(columns) + size - 1)), ...);
+		});
+		size--;
+	}
+
+	/* Remove the row at a specified index from every column by moving the last row into it's place. O(1), but doesn't maintain order.
+	@param index: Index to remove. */
+	void SwapRemoveAt(ArrInt index)
+	{
+		if (index >= size) {
+			return;
+		}
+		size--;
+		ForEachColumnIndex([&]<size_t... I>(std::index_sequence<I...>) {
+			((index != size ? void(std::get<I>(columns)[index] = std::move(std::get<I>(columns)[size])) : void(),
+				std::destroy_at(std::get<I>(columns) + size)), ...);
+		});
+	}
+
+	/* Remove every row, keeping the capacity. */
+	void Clear()
+	{
+		DestroyElements();
+		size = 0;
+	}
+};
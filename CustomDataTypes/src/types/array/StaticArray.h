@@ -109,6 +109,16 @@ public:
 		}
 	}
 
+	/* Get a pointer to the first element of this array. */
+	T* GetData() {
+		return data;
+	}
+
+	/* Get a pointer to the first element of this array. */
+	const T* GetData() const {
+		return data;
+	}
+
 	
 };
 
@@ -0,0 +1,259 @@
+#include "MappedFile.h"
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+	SetClosed();
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	SetClosed();
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator = (MappedFile&& other) noexcept
+{
+	if (this == &other) {
+		return *this;
+	}
+	Close();
+	data = other.data;
+	size = other.size;
+	readOnly = other.readOnly;
+#if defined(_WIN32)
+	fileHandle = other.fileHandle;
+	mappingHandle = other.mappingHandle;
+#else
+	fileDescriptor = other.fileDescriptor;
+#endif
+	other.SetClosed();
+	return *this;
+}
+
+#if defined(_WIN32)
+
+void MappedFile::SetClosed()
+{
+	data = nullptr;
+	size = 0;
+	readOnly = false;
+	fileHandle = INVALID_HANDLE_VALUE;
+	mappingHandle = nullptr;
+}
+
+bool MappedFile::IsOpen() const
+{
+	return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+bool MappedFile::Open(const char* path, bool openReadOnly)
+{
+	Close();
+	HANDLE file = CreateFileA(path, openReadOnly ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+		openReadOnly ? OPEN_EXISTING : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	size = (size_t)fileSize.QuadPart;
+	readOnly = openReadOnly;
+	if (!Map()) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool MappedFile::Map()
+{
+	if (size == 0) {
+		return true;
+	}
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, readOnly ? PAGE_READONLY : PAGE_READWRITE, 0, 0, nullptr);
+	if (mappingHandle == nullptr) {
+		return false;
+	}
+	data = MapViewOfFile(mappingHandle, readOnly ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, 0);
+	return data != nullptr;
+}
+
+void MappedFile::Unmap()
+{
+	if (data) {
+		UnmapViewOfFile(data);
+		data = nullptr;
+	}
+	if (mappingHandle) {
+		CloseHandle(mappingHandle);
+		mappingHandle = nullptr;
+	}
+}
+
+void MappedFile::Close()
+{
+	if (!IsOpen()) {
+		return;
+	}
+	Unmap();
+	CloseHandle(fileHandle);
+	SetClosed();
+}
+
+bool MappedFile::Resize(size_t newSize)
+{
+	if (!IsOpen() || readOnly) {
+		return false;
+	}
+
+	// A file can't be resized while a view of it is mapped.
+	Unmap();
+	LARGE_INTEGER position;
+	position.QuadPart = (LONGLONG)newSize;
+	if (!SetFilePointerEx(fileHandle, position, nullptr, FILE_BEGIN) || !SetEndOfFile(fileHandle)) {
+		Map();
+		return false;
+	}
+	size = newSize;
+	return Map();
+}
+
+bool MappedFile::Flush()
+{
+	if (!IsOpen() || readOnly) {
+		return IsOpen();
+	}
+	if (data && !FlushViewOfFile(data, 0)) {
+		return false;
+	}
+	return FlushFileBuffers(fileHandle) != 0;
+}
+
+#else
+
+void MappedFile::SetClosed()
+{
+	data = nullptr;
+	size = 0;
+	readOnly = false;
+	fileDescriptor = -1;
+}
+
+bool MappedFile::IsOpen() const
+{
+	return fileDescriptor != -1;
+}
+
+bool MappedFile::Open(const char* path, bool openReadOnly)
+{
+	Close();
+	const int file = openReadOnly ? open(path, O_RDONLY) : open(path, O_RDWR | O_CREAT, 0644);
+	if (file == -1) {
+		return false;
+	}
+
+	struct stat status;
+	if (fstat(file, &status) != 0) {
+		close(file);
+		return false;
+	}
+
+	fileDescriptor = file;
+	size = (size_t)status.st_size;
+	readOnly = openReadOnly;
+	if (!Map()) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool MappedFile::Map()
+{
+	if (size == 0) {
+		return true;
+	}
+	void* mapping = mmap(nullptr, size, readOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+	data = mapping;
+	return true;
+}
+
+void MappedFile::Unmap()
+{
+	if (data) {
+		munmap(data, size);
+		data = nullptr;
+	}
+}
+
+void MappedFile::Close()
+{
+	if (!IsOpen()) {
+		return;
+	}
+	Unmap();
+	close(fileDescriptor);
+	SetClosed();
+}
+
+bool MappedFile::Resize(size_t newSize)
+{
+	if (!IsOpen() || readOnly) {
+		return false;
+	}
+	if (ftruncate(fileDescriptor, (off_t)newSize) != 0) {
+		return false;
+	}
+
+#if defined(__linux__)
+	// Grow or shrink the existing mapping in place, or move it's pages, without unmapping.
+	if (data && newSize > 0) {
+		void* mapping = mremap(data, size, newSize, MREMAP_MAYMOVE);
+		if (mapping != MAP_FAILED) {
+			data = mapping;
+			size = newSize;
+			return true;
+		}
+	}
+#endif
+
+	Unmap();
+	size = newSize;
+	return Map();
+}
+
+bool MappedFile::Flush()
+{
+	if (!IsOpen() || readOnly) {
+		return IsOpen();
+	}
+	return data == nullptr || msync(data, size, MS_SYNC) == 0;
+}
+
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+File mapped into memory in it's entirety, so it's contents can be read and written through a pointer.
+Writes go to the OS page cache, and reach the disk in the background or when flushed.
+On POSIX systems this uses mmap (and mremap on Linux to grow without unmapping). On Windows it uses file mapping objects.
+*/
+class MappedFile
+{
+private:
+
+	/* Start of the mapped file contents. nullptr if the file is empty or not open. */
+	void* data;
+
+	/* Size of the file, and of the mapping, in bytes. */
+	size_t size;
+
+	bool readOnly;
+
+#if defined(_WIN32)
+	void* fileHandle;
+	void* mappingHandle;
+#else
+	int fileDescriptor;
+#endif
+
+	/* Map the whole file at it's current size. */
+	bool Map();
+
+	/* Unmap the file, leaving it open. */
+	void Unmap();
+
+	/* Reset to the closed state, without closing anything. */
+	void SetClosed();
+
+public:
+
+	/* Construct a closed file. */
+	MappedFile();
+
+	/* Unmaps and closes the file without flushing. Call Flush() first to write the contents to disk synchronously. */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	void operator = (const MappedFile&) = delete;
+
+	/* Move constructor. Takes over the other file's mapping, leaving it closed. */
+	MappedFile(MappedFile&& other) noexcept;
+
+	/* Move assignment. Closes this file, and takes over the other file's mapping, leaving it closed. */
+	MappedFile& operator = (MappedFile&& other) noexcept;
+
+	/* Open and map a file. Closes any file that was already open.
+	@param path: Path of the file.
+	@param openReadOnly: Map the file read only. The file must already exist. Otherwise it is created if it doesn't exist.
+	@returns If the file was opened and mapped. */
+	bool Open(const char* path, bool openReadOnly);
+
+	/* Unmap and close the file. Does nothing if not open. */
+	void Close();
+
+	/* Change the size of the file, and remap it. The contents up to the smaller of the old and new sizes are kept, and added bytes are zero.
+	The mapping may move, invalidating pointers into it.
+	@returns If the file was resized. Always false for read only files. */
+	bool Resize(size_t newSize);
+
+	/* Synchronously write the modified contents of the mapping to disk.
+	@returns If the flush succeeded. */
+	bool Flush();
+
+	bool IsOpen() const;
+
+	bool IsReadOnly() const { return readOnly; }
+
+	/* Get the start of the mapped contents. nullptr if the file is empty or not open. */
+	void* Data() const { return data; }
+
+	/* Get the size of the file in bytes. */
+	size_t Size() const { return size; }
+};
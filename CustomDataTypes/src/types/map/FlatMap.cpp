@@ -0,0 +1,148 @@
+#include "FlatMap.h"
+#include <types/test/UnitTest.h>
+
+#ifdef RUN_UNIT_TESTS_AT_COMPILE
+namespace FlatMapCompileUnitTests
+{
+	/* The branchless bounds must agree with std::lower_bound and std::upper_bound for every key, on every prefix of a sorted array with duplicates. */
+	constexpr bool FlatBoundsMatchStd()
+	{
+		constexpr int sorted[] = { 1, 2, 2, 2, 4, 5, 5, 8, 9, 9, 9, 9, 12 };
+		constexpr ArrInt count = ArrInt(sizeof(sorted) / sizeof(int));
+		for (ArrInt n = 0; n <= count; n++) {
+			for (int key = 0; key <= 13; key++) {
+				const ArrInt lower = FlatInternal::LowerBound(sorted, n, key, std::less<int>());
+				const ArrInt upper = FlatInternal::UpperBound(sorted, n, key, std::less<int>());
+				if (lower != ArrInt(std::lower_bound(sorted, sorted + n, key) - sorted)) return false;
+				if (upper != ArrInt(std::upper_bound(sorted, sorted + n, key) - sorted)) return false;
+			}
+		}
+		const flat_set<int> set = { 9, 1, 5 };
+		return set.LowerBound(5) == 1 && set.UpperBound(5) == 2 && set.LowerBound(10) == 3 && set.UpperBound(0) == 0;
+	}
+	TEST_ASSERT(FlatBoundsMatchStd());
+
+	/* InsertMany merges a batch into the set, skipping values already in the set or repeated within the batch. */
+	constexpr bool FlatSetInsertMany()
+	{
+		flat_set<int> set = { 5, 1, 3, 5 };
+		if (set.Size() != 3) return false;
+		set.InsertMany({ 4, 3, 9, 1, 4, 0, 9 });
+		constexpr int expected[] = { 0, 1, 3, 4, 5, 9 };
+		if (set.Size() != 6) return false;
+		for (ArrInt i = 0; i < set.Size(); i++) {
+			if (set[i] != expected[i]) return false;
+		}
+
+		flat_set<int, std::greater<int>> descending = { 2, 7 };
+		descending.InsertMany({ 7, 1, 8 });
+		return descending.Size() == 4 && descending[0] == 8 && descending[1] == 7 && descending[3] == 1 && !descending.Insert(2);
+	}
+	TEST_ASSERT(FlatSetInsertMany());
+
+	/* For equivalent keys within a batch the last pair wins, both when building and when merging into existing pairs. */
+	constexpr bool FlatMapBatchLastWins()
+	{
+		constexpr int keys[] = { 3, 1, 3, 2, 1 };
+		constexpr int values[] = { 10, 20, 30, 40, 50 };
+		flat_map<int, int> map(keys, values, 5);
+		if (map.Size() != 3 || map.GetKeys()[0] != 1 || map.GetKeys()[2] != 3) return false;
+		if (*map.Find(1) != 50 || *map.Find(2) != 40 || *map.Find(3) != 30) return false;
+
+		constexpr int moreKeys[] = { 2, 5, 2, 0 };
+		constexpr int moreValues[] = { 1, 2, 3, 4 };
+		map.InsertMany(moreKeys, moreValues, 4);
+		constexpr int expectedKeys[] = { 0, 1, 2, 3, 5 };
+		constexpr int expectedValues[] = { 4, 50, 3, 30, 2 };
+		if (map.Size() != 5) return false;
+		for (ArrInt i = 0; i < map.Size(); i++) {
+			if (map.GetKeys()[i] != expectedKeys[i] || map.GetValues()[i] != expectedValues[i]) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(FlatMapBatchLastWins());
+
+	/* InsertOrAssign returns the key's value whether it inserted or assigned, and Remove moves out the removed value. */
+	constexpr bool FlatMapInsertOrAssignRemove()
+	{
+		flat_map<int, int> map;
+		if (!map.Insert(4, 40) || map.Insert(4, 41) || *map.Find(4) != 40) return false;
+		map.InsertOrAssign(2, 20) += 1;
+		map.InsertOrAssign(4, 42) += 1;
+		if (map.Size() != 2 || *map.Find(2) != 21 || *map.Find(4) != 43) return false;
+
+		int removed = -1;
+		if (map.Remove(3, &removed) || removed != -1) return false;
+		if (!map.Remove(2, &removed) || removed != 21) return false;
+		return map.Size() == 1 && !map.Contains(2) && map.Contains(4) && map.LowerBound(3) == 0;
+	}
+	TEST_ASSERT(FlatMapInsertOrAssignRemove());
+
+	struct Tagged
+	{
+		int key;
+		int tag;
+	};
+
+	struct TaggedLess
+	{
+		constexpr bool operator () (const Tagged& left, const Tagged& right) const { return left.key < right.key; }
+	};
+
+	/* InsertMany keeps the element already in the set over an equivalent one in the batch, and only one of equivalent elements within the batch. */
+	constexpr bool FlatSetInsertManyDuplicates()
+	{
+		flat_set<Tagged, TaggedLess> set = { { 1, 0 }, { 3, 0 } };
+		set.InsertMany({ { 3, 1 }, { 2, 1 }, { 2, 2 }, { 1, 1 }, { 2, 3 } });
+		if (set.Size() != 3 || set[0].key != 1 || set[1].key != 2 || set[2].key != 3) return false;
+		if (set[0].tag != 0 || set[2].tag != 0 || set[1].tag == 0) return false;
+
+		// A batch of only existing elements, and an empty batch, change nothing.
+		set.InsertMany({ { 3, 4 }, { 1, 4 }, { 3, 5 } });
+		set.InsertMany(nullptr, 0);
+		if (set.Size() != 3 || set[0].tag != 0 || set[2].tag != 0) return false;
+
+		// A batch of one repeated element, into an empty set.
+		flat_set<int> repeated;
+		repeated.InsertMany({ 7, 7, 7, 7 });
+		if (repeated.Size() != 1 || repeated[0] != 7) return false;
+
+		// Batch elements on both sides of, and between, the existing ones.
+		repeated.InsertMany({ 9, 0, 7, 8, 0, 9 });
+		constexpr int expected[] = { 0, 7, 8, 9 };
+		if (repeated.Size() != 4) return false;
+		for (ArrInt i = 0; i < repeated.Size(); i++) {
+			if (repeated[i] != expected[i]) return false;
+		}
+		return true;
+	}
+	TEST_ASSERT(FlatSetInsertManyDuplicates());
+
+	/* InsertMany assigns existing keys the value of the last equivalent pair in the batch, without adding pairs. */
+	constexpr bool FlatMapInsertManyDuplicates()
+	{
+		constexpr int keys[] = { 1, 3 };
+		constexpr int values[] = { 10, 30 };
+		flat_map<int, int> map(keys, values, 2);
+
+		constexpr int batchKeys[] = { 3, 2, 3, 1, 2 };
+		constexpr int batchValues[] = { 31, 20, 32, 11, 21 };
+		map.InsertMany(batchKeys, batchValues, 5);
+		if (map.Size() != 3 || *map.Find(1) != 11 || *map.Find(2) != 21 || *map.Find(3) != 32) return false;
+
+		// A batch of only existing keys.
+		constexpr int existingKeys[] = { 1, 1, 1 };
+		constexpr int existingValues[] = { 5, 6, 7 };
+		map.InsertMany(existingKeys, existingValues, 3);
+		if (map.Size() != 3 || *map.Find(1) != 7 || *map.Find(2) != 21) return false;
+
+		// A batch of one repeated key, into an empty map.
+		flat_map<int, int> empty;
+		constexpr int repeatedKeys[] = { 4, 4 };
+		constexpr int repeatedValues[] = { 1, 2 };
+		empty.InsertMany(repeatedKeys, repeatedValues, 2);
+		return empty.Size() == 1 && *empty.Find(4) == 2;
+	}
+	TEST_ASSERT(FlatMapInsertManyDuplicates());
+}
+#endif
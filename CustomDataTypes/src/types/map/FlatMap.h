@@ -0,0 +1,484 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <types/array/DynamicArray.h>
+
+namespace FlatInternal {
+
+	/* Index of the first element that does not compare less than the key, or count if there is none.
+	Each step picks the half to keep with a conditional move rather than a branch, so the loop runs a fixed log2(count) iterations
+	without branch mispredictions. */
+	template<typename T, typename Key, typename Compare>
+	constexpr ArrInt LowerBound(const T* elements, ArrInt count, const Key& key, const Compare& comp)
+	{
+		if (count == 0) {
+			return 0;
+		}
+		const T* base = elements;
+		while (count > 1) {
+			const ArrInt half = count / 2;
+			base = comp(base[half - 1], key) ? base + half : base;
+			count -= half;
+		}
+		return ArrInt(base - elements) + ArrInt(comp(*base, key));
+	}
+
+	/* Index of the first element that compares greater than the key, or count if there is none. Branchless, see LowerBound(). */
+	template<typename T, typename Key, typename Compare>
+	constexpr ArrInt UpperBound(const T* elements, ArrInt count, const Key& key, const Compare& comp)
+	{
+		if (count == 0) {
+			return 0;
+		}
+		const T* base = elements;
+		while (count > 1) {
+			const ArrInt half = count / 2;
+			base = !comp(key, base[half - 1]) ? base + half : base;
+			count -= half;
+		}
+		return ArrInt(base - elements) + ArrInt(!comp(key, *base));
+	}
+
+	/* Whether two keys are equivalent under a strict weak ordering. */
+	template<typename T, typename Compare>
+	constexpr bool Equivalent(const T& left, const T& right, const Compare& comp)
+	{
+		return !comp(left, right) && !comp(right, left);
+	}
+}
+
+/*
+Sorted set stored in a single darray, giving binary searches over contiguous memory instead of walking nodes or buckets.
+Lookups are O(log n) with a branchless lower bound. Single inserts and removals shift the elements after them, so it suits read mostly sets.
+Build large sets with the bulk constructor or InsertMany(), which sort the new elements once and merge them in a single pass.
+Inserting or removing invalidates pointers to elements.
+
+@param - T: Type the set contains. Must be copyable, and ordered by Compare.
+@param - Compare (optional. default std::less<T>): Strict weak ordering of the elements.
+*/
+template<typename T, typename Compare = std::less<T>>
+struct flat_set
+{
+private:
+
+	/* Sorted, with no equivalent elements. */
+	darray<T> elements;
+
+	Compare comp;
+
+	/* Sort an array of elements, and remove all but one of each equivalent run. */
+	constexpr void SortUnique(darray<T>& arr) const
+	{
+		T* data = arr.GetData();
+		std::sort(data, data + arr.Size(), comp);
+		const ArrInt uniqueCount = ArrInt(std::unique(data, data + arr.Size(),
+			[this](const T& left, const T& right) { return FlatInternal::Equivalent(left, right, comp); }) - data);
+		arr.Truncate(uniqueCount);
+	}
+
+public:
+
+	/* Default constructor. */
+	constexpr flat_set(const Compare& _comp = Compare())
+		: comp(_comp)
+	{}
+
+	/* Bulk constructor. Sorts the elements once, keeping one of any equivalent elements.
+	@param start: Pointer to an array of T value(s).
+	@param amount: Amount of T's to add. */
+	constexpr flat_set(const T* start, ArrInt amount, const Compare& _comp = Compare())
+		: comp(_comp)
+	{
+		elements.InsertElements(start, amount);
+		SortUnique(elements);
+	}
+
+	/* Initializer list constructor. See the bulk constructor. */
+	constexpr flat_set(const std::initializer_list<T>& il, const Compare& _comp = Compare())
+		: flat_set(il.begin(), ArrInt(il.size()), _comp)
+	{}
+
+	constexpr const T* begin() const { return elements.GetData(); }
+	constexpr const T* end() const { return elements.GetData() + elements.Size(); }
+
+	/* Get the amount of elements. */
+	constexpr ArrInt Size() const { return elements.Size(); }
+
+	/* Get a reference to the element at a sorted index. Will only check if correct index if ARRAY_CHECK_OUT_OF_BOUNDS macro is set. */
+	constexpr const T& At(ArrInt index) const
+	{
+		#if ARRAY_CHECK_OUT_OF_BOUNDS == true
+		if (index >= elements.Size()) {
+			_ArrayError("Index out of bounds from flat_set::At().");
+			abort();
+		}
+		#endif
+		return elements.GetData()[index];
+	}
+
+	/* Index of operator. See At(). */
+	constexpr const T& operator [] (ArrInt index) const
+	{
+		return At(index);
+	}
+
+	/* Index of the first element not less than a value, or Size() if there is none. */
+	constexpr ArrInt LowerBound(const T& value) const
+	{
+		return FlatInternal::LowerBound(elements.GetData(), elements.Size(), value, comp);
+	}
+
+	/* Index of the first element greater than a value, or Size() if there is none. */
+	constexpr ArrInt UpperBound(const T& value) const
+	{
+		return FlatInternal::UpperBound(elements.GetData(), elements.Size(), value, comp);
+	}
+
+	/* Check if the set contains a value.
+	@param indexOut (optional): Out param for the found index. */
+	constexpr bool Contains(const T& value, ArrInt* indexOut = nullptr) const
+	{
+		const ArrInt index = LowerBound(value);
+		if (index == elements.Size() || comp(value, elements.GetData()[index])) {
+			return false;
+		}
+		if (indexOut) {
+			*indexOut = index;
+		}
+		return true;
+	}
+
+	/* Insert a value, shifting every greater element over by 1.
+	@returns If the value was inserted. False if an equivalent value is already in the set. */
+	constexpr bool Insert(const T& value)
+	{
+		const ArrInt index = LowerBound(value);
+		if (index < elements.Size() && !comp(value, elements.GetData()[index])) {
+			return false;
+		}
+		if (index == elements.Size()) {
+			elements.Add(value);
+		}
+		else {
+			elements.InsertAt(value, index);
+		}
+		return true;
+	}
+
+	/* Insert many values with a single sort of the new values, and a single merge pass over the set.
+	Values equivalent to ones already in the set, or earlier in the batch, are skipped.
+	@param start: Pointer to an array of T value(s).
+	@param amount: Amount of T's to insert. */
+	constexpr void InsertMany(const T* start, ArrInt amount)
+	{
+		if (amount == 0) {
+			return;
+		}
+		darray<T> incoming;
+		incoming.InsertElements(start, amount);
+		SortUnique(incoming);
+
+		darray<T> merged;
+		merged.Reserve(elements.Size() + incoming.Size());
+		const T* existing = elements.GetData();
+		const T* added = incoming.GetData();
+		ArrInt e = 0;
+		ArrInt a = 0;
+		while (e < elements.Size() && a < incoming.Size()) {
+			if (comp(added[a], existing[e])) {
+				merged.Add(std::move(incoming[a++]));
+			}
+			else {
+				if (!comp(existing[e], added[a])) {
+					a++;
+				}
+				merged.Add(std::move(elements[e++]));
+			}
+		}
+		for (; e < elements.Size(); e++) {
+			merged.Add(std::move(elements[e]));
+		}
+		for (; a < incoming.Size(); a++) {
+			merged.Add(std::move(incoming[a]));
+		}
+		elements = std::move(merged);
+	}
+
+	/* Insert many values from an initializer list. See InsertMany(). */
+	constexpr void InsertMany(const std::initializer_list<T>& il)
+	{
+		InsertMany(il.begin(), ArrInt(il.size()));
+	}
+
+	/* Remove a value, shifting every greater element back by 1.
+	@returns If the value was in the set. */
+	constexpr bool Remove(const T& value)
+	{
+		ArrInt index;
+		if (!Contains(value, &index)) {
+			return false;
+		}
+		elements.RemoveAt(index);
+		return true;
+	}
+
+	/* Remove every element. */
+	constexpr void Clear()
+	{
+		elements = darray<T>();
+	}
+
+	/* Increase capacity to the supplied value IF the current capacity is less than the supplied. */
+	constexpr void Reserve(ArrInt newCapacity)
+	{
+		elements.Reserve(newCapacity);
+	}
+
+	/* Get the sorted elements. */
+	constexpr const T* GetData() const
+	{
+		return elements.GetData();
+	}
+};
+
+/*
+Sorted map storing it's keys and values in two separate darrays, so lookups binary search over densely packed keys only,
+and touch a single value once found. Lookups are O(log n) with a branchless lower bound.
+Single inserts and removals shift the pairs after them, so it suits read mostly tables. Build large maps with the bulk constructor
+or InsertMany(), which sort the new pairs once and merge them in a single pass.
+Inserting or removing invalidates pointers to keys and values.
+
+@param - K: Key type. Must be copyable, and ordered by Compare.
+@param - V: Value type.
+@param - Compare (optional. default std::less<K>): Strict weak ordering of the keys.
+*/
+template<typename K, typename V, typename Compare = std::less<K>>
+struct flat_map
+{
+private:
+
+	/* Sorted, with no equivalent keys. */
+	darray<K> keys;
+
+	/* Value of the key at the same index. */
+	darray<V> values;
+
+	Compare comp;
+
+	/* Sort a batch of pairs by key, keeping the last pair of any equivalent keys.
+	@param outKeys: The sorted unique keys.
+	@param outValues: Value of each sorted key. */
+	constexpr void SortUniquePairs(const K* inKeys, const V* inValues, ArrInt amount, darray<K>& outKeys, darray<V>& outValues) const
+	{
+		darray<ArrInt> order;
+		order.Reserve(amount);
+		for (ArrInt i = 0; i < amount; i++) {
+			order.Add(i);
+		}
+		// Equivalent keys are ordered by their position in the batch, so the last one can be kept.
+		std::sort(order.GetData(), order.GetData() + amount, [&](ArrInt left, ArrInt right) {
+			if (comp(inKeys[left], inKeys[right])) {
+				return true;
+			}
+			return !comp(inKeys[right], inKeys[left]) && left < right;
+		});
+
+		outKeys.Reserve(amount);
+		outValues.Reserve(amount);
+		for (ArrInt i = 0; i < amount; i++) {
+			const ArrInt index = order[i];
+			// Later pairs in the batch replace earlier ones with an equivalent key.
+			if (i + 1 < amount && !comp(inKeys[index], inKeys[order[i + 1]])) {
+				continue;
+			}
+			outKeys.Add(inKeys[index]);
+			outValues.Add(inValues[index]);
+		}
+	}
+
+	/* Insert a pair at a sorted index, shifting the pairs after it over by 1. */
+	constexpr void InsertAtIndex(const K& key, const V& value, ArrInt index)
+	{
+		if (index == keys.Size()) {
+			keys.Add(key);
+			values.Add(value);
+		}
+		else {
+			keys.InsertAt(key, index);
+			values.InsertAt(value, index);
+		}
+	}
+
+public:
+
+	/* Default constructor. */
+	constexpr flat_map(const Compare& _comp = Compare())
+		: comp(_comp)
+	{}
+
+	/* Bulk constructor. Sorts the pairs once. For equivalent keys, the last pair's value is kept.
+	@param inKeys: Pointer to an array of keys.
+	@param inValues: Pointer to an array of values, one for each key.
+	@param amount: Amount of pairs to add. */
+	constexpr flat_map(const K* inKeys, const V* inValues, ArrInt amount, const Compare& _comp = Compare())
+		: comp(_comp)
+	{
+		SortUniquePairs(inKeys, inValues, amount, keys, values);
+	}
+
+	/* Get the amount of pairs. */
+	constexpr ArrInt Size() const { return keys.Size(); }
+
+	/* Get the sorted keys. */
+	constexpr const K* GetKeys() const { return keys.GetData(); }
+
+	/* Get the values, in the same order as the keys. */
+	constexpr V* GetValues() { return values.GetData(); }
+
+	/* Get the values, in the same order as the keys. */
+	constexpr const V* GetValues() const { return values.GetData(); }
+
+	/* Index of the first key not less than a key, or Size() if there is none. */
+	constexpr ArrInt LowerBound(const K& key) const
+	{
+		return FlatInternal::LowerBound(keys.GetData(), keys.Size(), key, comp);
+	}
+
+	/* Index of the first key greater than a key, or Size() if there is none. */
+	constexpr ArrInt UpperBound(const K& key) const
+	{
+		return FlatInternal::UpperBound(keys.GetData(), keys.Size(), key, comp);
+	}
+
+	/* Find the value of a key.
+	@param indexOut (optional): Out param for the found index.
+	@returns Pointer to the value, or nullptr if the key is not in the map. */
+	constexpr V* Find(const K& key, ArrInt* indexOut = nullptr)
+	{
+		const ArrInt index = LowerBound(key);
+		if (index == keys.Size() || comp(key, keys.GetData()[index])) {
+			return nullptr;
+		}
+		if (indexOut) {
+			*indexOut = index;
+		}
+		return values.GetData() + index;
+	}
+
+	/* Find the value of a key. See Find(). */
+	constexpr const V* Find(const K& key, ArrInt* indexOut = nullptr) const
+	{
+		return const_cast<flat_map*>(this)->Find(key, indexOut);
+	}
+
+	/* Check if the map contains a key. */
+	constexpr bool Contains(const K& key) const
+	{
+		return Find(key) != nullptr;
+	}
+
+	/* Insert a pair, shifting every pair with a greater key over by 1.
+	@returns If the pair was inserted. False if the key is already in the map, in which case it's value is unchanged. */
+	constexpr bool Insert(const K& key, const V& value)
+	{
+		const ArrInt index = LowerBound(key);
+		if (index < keys.Size() && !comp(key, keys.GetData()[index])) {
+			return false;
+		}
+		InsertAtIndex(key, value, index);
+		return true;
+	}
+
+	/* Insert a pair, or assign the value if the key is already in the map.
+	@returns Reference to the key's value. */
+	constexpr V& InsertOrAssign(const K& key, const V& value)
+	{
+		const ArrInt index = LowerBound(key);
+		if (index < keys.Size() && !comp(key, keys.GetData()[index])) {
+			values[index] = value;
+		}
+		else {
+			InsertAtIndex(key, value, index);
+		}
+		return values[index];
+	}
+
+	/* Insert many pairs with a single sort of the new pairs, and a single merge pass over the map.
+	Keys already in the map have their values assigned. For equivalent keys within the batch, the last pair wins.
+	@param inKeys: Pointer to an array of keys.
+	@param inValues: Pointer to an array of values, one for each key.
+	@param amount: Amount of pairs to insert. */
+	constexpr void InsertMany(const K* inKeys, const V* inValues, ArrInt amount)
+	{
+		if (amount == 0) {
+			return;
+		}
+		darray<K> addedKeys;
+		darray<V> addedValues;
+		SortUniquePairs(inKeys, inValues, amount, addedKeys, addedValues);
+
+		darray<K> mergedKeys;
+		darray<V> mergedValues;
+		mergedKeys.Reserve(keys.Size() + addedKeys.Size());
+		mergedValues.Reserve(keys.Size() + addedKeys.Size());
+		ArrInt e = 0;
+		ArrInt a = 0;
+		while (e < keys.Size() && a < addedKeys.Size()) {
+			if (comp(addedKeys[a], keys[e])) {
+				mergedKeys.Add(std::move(addedKeys[a]));
+				mergedValues.Add(std::move(addedValues[a]));
+				a++;
+			}
+			else if (comp(keys[e], addedKeys[a])) {
+				mergedKeys.Add(std::move(keys[e]));
+				mergedValues.Add(std::move(values[e]));
+				e++;
+			}
+			else {
+				mergedKeys.Add(std::move(keys[e]));
+				mergedValues.Add(std::move(addedValues[a]));
+				e++;
+				a++;
+			}
+		}
+		for (; e < keys.Size(); e++) {
+			mergedKeys.Add(std::move(keys[e]));
+			mergedValues.Add(std::move(values[e]));
+		}
+		for (; a < addedKeys.Size(); a++) {
+			mergedKeys.Add(std::move(addedKeys[a]));
+			mergedValues.Add(std::move(addedValues[a]));
+		}
+		keys = std::move(mergedKeys);
+		values = std::move(mergedValues);
+	}
+
+	/* Remove a key and it's value, shifting every pair with a greater key back by 1.
+	@param outValue (optional): Pointer to value type to move the removed value to.
+	@returns If the key was in the map. */
+	constexpr bool Remove(const K& key, V* outValue = nullptr)
+	{
+		ArrInt index;
+		if (Find(key, &index) == nullptr) {
+			return false;
+		}
+		keys.RemoveAt(index);
+		values.RemoveAt(index, outValue);
+		return true;
+	}
+
+	/* Remove every pair. */
+	constexpr void Clear()
+	{
+		keys = darray<K>();
+		values = darray<V>();
+	}
+
+	/* Increase capacity to the supplied value IF the current capacity is less than the supplied. */
+	constexpr void Reserve(ArrInt newCapacity)
+	{
+		keys.Reserve(newCapacity);
+		values.Reserve(newCapacity);
+	}
+};
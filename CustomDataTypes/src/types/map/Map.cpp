@@ -1,11 +1,11 @@
 #include "Map.h"
 
-ArrInt MapHash::Hash(int key)
+ArrInt MapHash::Hash(const int& key)
 {
 	return key;
 }
 
-constexpr ArrInt SomeHash(int key) {
+constexpr ArrInt SomeHash(const int& key) {
 	return key;
 }
 
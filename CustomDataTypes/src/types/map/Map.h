@@ -1,15 +1,17 @@
 #pragma once
 
-#include <types/array/DynamicArray.h>
+#include <types/array/SmallArray.h>
 #include <iostream>
 
 typedef unsigned int uint;
 constexpr size_t MAP_INITIAL_CAPACITY = 16;
 constexpr double LOAD_FACTOR_FOR_RESIZE = 0.75;
 constexpr ArrInt HUGE_BUCKET_SIZE = 8;
+/* Amount of pairs each bucket stores without a heap allocation. */
+constexpr size_t MAP_BUCKET_INLINE_CAPACITY = 2;
 
 namespace MapHash {
-	ArrInt Hash(int key);
+	ArrInt Hash(const int& key);
 }
 
 template<typename K, typename V>
@@ -19,12 +21,14 @@ struct Pair
 	V value;
 };
 
-template<typename K, typename V, ArrInt(*MapHasher)(K) = MapHash::Hash>
+/* @param - MapHasher (optional. default MapHash::Hash for int keys): Hash function taking the key by const reference, so keys that cache their hash,
+such as String with HashString, reuse the hash cached in the stored key. */
+template<typename K, typename V, ArrInt(*MapHasher)(const K&) = MapHash::Hash>
 struct Map
 {
 	struct Bucket 
 	{
-		darray<Pair<K, V>> elements;
+		small_darray<Pair<K, V>, MAP_BUCKET_INLINE_CAPACITY> elements;
 
 		V* Find(const K& key) {
 			for (ArrInt i = 0; i < elements.Size(); i++) {
@@ -36,25 +40,20 @@ struct Map
 		}
 	};
 
-	//Array<Bucket> buckets;
-
-	Bucket* buckets;
+	darray<Bucket> buckets;
 
 	ArrInt bucketCount;
 
 	ArrInt elementCount;
 
-	constexpr Map() {
-		//bucketCount = MAP_INITIAL_CAPACITY;
-		//bucketsalt = MakeNewBucketArray(bucketCount);
-
-		//buckets.Reserve(MAP_INITIAL_CAPACITY);
-		//buckets.FillWith(Bucket());
-		//elementCount = 0;
-	}
+	/* Rehash and bucket length counters. Occupies no space unless CONTAINER_STATS is enabled. */
+	DARRAY_NO_UNIQUE_ADDRESS container_stats_tracker stats;
 
-	constexpr ~Map() {
-		delete[] buckets;
+	constexpr Map() {
+		bucketCount = MAP_INITIAL_CAPACITY;
+		buckets.Reserve(MAP_INITIAL_CAPACITY);
+		buckets.FillWith(Bucket());
+		elementCount = 0;
 	}
 
 	static ArrInt ComputeHash(const K& key) {
@@ -74,9 +73,10 @@ struct Map
 		const ArrInt bucketIndex = GetBucketForKey(bucketCount, keyValuePair.key);
 		buckets[bucketIndex].elements.Add(keyValuePair);
 		elementCount++;
+		stats.BucketLength(buckets[bucketIndex].elements.Size());
 	}
 
-	void Add(const K& key, const K& value) 
+	void Add(const K& key, const V& value) 
 	{
 		Add({ key, value });
 	}
@@ -111,22 +111,23 @@ struct Map
 		for (ArrInt b = 0; b < buckets.Size(); b++) {
 			for (ArrInt p = 0; p < buckets[b].elements.Size(); p++) {
 
-				const Pair<K, V>& keyValuePair = buckets[b].elements[p];
+				Pair<K, V>& keyValuePair = buckets[b].elements[p];
 				const ArrInt bucketIndex = GetBucketForKey(newBuckets.Size(), keyValuePair.key);
-				newBuckets[bucketIndex].elements.Add(keyValuePair);
+				newBuckets[bucketIndex].elements.Add(std::move(keyValuePair));
 			}
 		}
 
-		buckets = newBuckets;
+		buckets = std::move(newBuckets);
+		bucketCount = newBucketCount;
+		stats.Rehash();
+		stats.BytesCopied(sizeof(Pair<K, V>) * elementCount);
 	}
 
-	static constexpr Bucket* MakeNewBucketArray(const ArrInt NewBucketCount)
+	/* Get the rehashes, pairs moved by rehashing, and longest bucket of this map. All zeros unless CONTAINER_STATS is enabled.
+	Allocations of the bucket array are counted by it's own stats. */
+	ContainerStats GetStats() const
 	{
-		Bucket* newBuckets = new Bucket[NewBucketCount];
-		for (ArrInt i = 0; i < NewBucketCount; i++) {
-			newBuckets[i] = Bucket();
-		}
-		return newBuckets;
+		return stats.Get();
 	}
 };
 
@@ -0,0 +1,137 @@
+#include "MpmcQueue.h"
+#include <memory>
+#include <string>
+#include <types/test/UnitTest.h>
+
+#if RUNTIME_UNIT_TESTS == true
+namespace MpmcQueueRuntimeUnitTests
+{
+	/* Capacities round up to a power of 2, and non blocking pushes and pops stop at the full and empty edges in FIFO order. */
+	static void MpmcEdgeTests()
+	{
+		RUNTIME_TEST_ASSERT(mpmc_queue<int>(0).Capacity() == 2 && mpmc_queue<int>(5).Capacity() == 8 && mpmc_queue<int>(16).Capacity() == 16);
+
+		mpmc_queue<int> queue(4);
+		int value = -1;
+		RUNTIME_TEST_ASSERT(queue.Size() == 0 && !queue.TryPop(value) && value == -1);
+		for (int lap = 0; lap < 3; lap++) {
+			for (int i = 0; i < 4; i++) {
+				RUNTIME_TEST_ASSERT(queue.TryPush(lap * 4 + i));
+			}
+			RUNTIME_TEST_ASSERT(queue.Size() == 4 && !queue.TryPush(-1));
+			for (int i = 0; i < 4; i++) {
+				RUNTIME_TEST_ASSERT(queue.TryPop(value) && value == lap * 4 + i);
+			}
+			RUNTIME_TEST_ASSERT(queue.Size() == 0 && !queue.TryPop(value));
+		}
+
+		queue.Push(1);
+		queue.Push(2);
+		queue.Pop(value);
+		RUNTIME_TEST_ASSERT(value == 1 && queue.TryPop(value) && value == 2);
+
+		// A failed push doesn't move from the value.
+		mpmc_queue<std::string> strings(2);
+		std::string first(40, 'a');
+		strings.Push(std::move(first));
+		RUNTIME_TEST_ASSERT(first.empty() && strings.TryPush(std::string(40, 'b')));
+		std::string rejected(40, 'c');
+		RUNTIME_TEST_ASSERT(!strings.TryPush(std::move(rejected)) && rejected == std::string(40, 'c'));
+		std::string popped;
+		RUNTIME_TEST_ASSERT(strings.TryPop(popped) && popped == std::string(40, 'a'));
+	}
+	RUNTIME_TEST_SUITE(MpmcEdgeTests);
+
+	constexpr int PRODUCERS = 3;
+
+	constexpr int CONSUMERS = 3;
+
+	constexpr int PUSHES_PER_PRODUCER = 20000;
+
+	constexpr int TOTAL = PRODUCERS * PUSHES_PER_PRODUCER;
+
+	/* Run producers and consumers on their own threads through a small queue, so it's often full and empty,
+	then check every pushed value was popped exactly once, and each consumer saw each producer's values in order.
+	@param blocking: Use Push() and Pop() instead of TryPush() and TryPop(). */
+	static bool EveryValuePoppedOnce(bool blocking)
+	{
+		mpmc_queue<int> queue(16);
+		std::unique_ptr<std::atomic<int>[]> popCounts(new std::atomic<int>[TOTAL]);
+		for (int i = 0; i < TOTAL; i++) {
+			popCounts[i].store(0);
+		}
+		std::atomic<int> popped = 0;
+		std::atomic<bool> outOfOrder = false;
+
+		darray<std::thread> threads;
+		for (int p = 0; p < PRODUCERS; p++) {
+			threads.Add(std::thread([&queue, blocking, p]() {
+				for (int i = 0; i < PUSHES_PER_PRODUCER; i++) {
+					const int value = p * PUSHES_PER_PRODUCER + i;
+					if (blocking) {
+						queue.Push(value);
+					}
+					else {
+						while (!queue.TryPush(value)) {
+							std::this_thread::yield();
+						}
+					}
+				}
+			}));
+		}
+		for (int c = 0; c < CONSUMERS; c++) {
+			threads.Add(std::thread([&, c]() {
+				int lastFromProducer[PRODUCERS] = { -1, -1, -1 };
+				// Blocking consumers each pop an equal share, since a Pop() past the last push would wait forever.
+				const int share = TOTAL / CONSUMERS + (c < TOTAL % CONSUMERS);
+				for (int taken = 0; blocking ? taken < share : popped.load() < TOTAL;) {
+					int value;
+					if (blocking) {
+						queue.Pop(value);
+					}
+					else if (!queue.TryPop(value)) {
+						std::this_thread::yield();
+						continue;
+					}
+					taken++;
+					popped++;
+					popCounts[value]++;
+					const int producer = value / PUSHES_PER_PRODUCER;
+					if (value <= lastFromProducer[producer]) {
+						outOfOrder = true;
+					}
+					lastFromProducer[producer] = value;
+				}
+			}));
+		}
+		for (ArrInt i = 0; i < threads.Size(); i++) {
+			threads[i].join();
+		}
+
+		int value;
+		if (popped.load() != TOTAL || outOfOrder.load() || queue.Size() != 0 || queue.TryPop(value)) {
+			return false;
+		}
+		for (int i = 0; i < TOTAL; i++) {
+			if (popCounts[i].load() != 1) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Concurrent non blocking pushes and pops deliver every value exactly once. */
+	static void MpmcTryTests()
+	{
+		RUNTIME_TEST_ASSERT(EveryValuePoppedOnce(false));
+	}
+	RUNTIME_TEST_SUITE(MpmcTryTests);
+
+	/* Concurrent blocking pushes and pops deliver every value exactly once. */
+	static void MpmcBlockingTests()
+	{
+		RUNTIME_TEST_ASSERT(EveryValuePoppedOnce(true));
+	}
+	RUNTIME_TEST_SUITE(MpmcBlockingTests);
+}
+#endif
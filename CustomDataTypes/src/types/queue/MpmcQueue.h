@@ -0,0 +1,254 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <thread>
+#include <types/array/DynamicArray.h>
+
+/* Block waiting Push() and Pop() calls on the OS (futex on Linux, WaitOnAddress on Windows) through std::atomic::wait once spinning gives up.
+Set to false to yield the thread in a loop instead. */
+#ifndef MPMC_QUEUE_FUTEX_WAIT
+#define MPMC_QUEUE_FUTEX_WAIT true
+#endif
+
+/* Times a blocking Push() or Pop() rechecks it's slot before waiting. */
+#ifndef MPMC_QUEUE_SPIN_COUNT
+#define MPMC_QUEUE_SPIN_COUNT 64
+#endif
+
+/*
+Lock free bounded queue that any amount of threads can push to and pop from at once.
+Each slot of a fixed darray holds a sequence number that says which lap of the ring it's ready for,
+so a push or pop only contends on a single position counter and the slot it claims, instead of a shared lock. (Dmitry Vyukov's bounded queue)
+TryPush() and TryPop() never block, and fail when the queue is full or empty.
+Push() and Pop() take a ticket and wait for their slot, spinning briefly, then waiting through MPMC_QUEUE_FUTEX_WAIT.
+Slots are assigned into, so T must be default constructible and assignable.
+
+@param - T: Type the queue contains
+*/
+template<typename T>
+struct mpmc_queue
+{
+private:
+
+	struct Slot
+	{
+		/* Equal to a position when the slot is free for the push of that position, and 1 past it once the element is ready to pop. */
+		std::atomic<size_t> sequence;
+
+		T value;
+
+		Slot(size_t _sequence) : sequence(_sequence), value() {}
+
+		/* Only used by the array's relocation, which never runs since the array is filled to it's reserved capacity once. */
+		Slot(const Slot& other) : sequence(other.sequence.load(std::memory_order_relaxed)), value(other.value) {}
+	};
+
+	/* Never grows after construction, so slots never move. */
+	darray<Slot> slots;
+
+	size_t indexMask;
+
+	/* Position of the next push. */
+	alignas(64) std::atomic<size_t> enqueuePos;
+
+	/* Position of the next pop. The alignment also pads the queue's size, so nothing after it shares this line. */
+	alignas(64) std::atomic<size_t> dequeuePos;
+
+	/* Wait until a slot's sequence reaches an expected value. */
+	static void WaitForSequence(Slot& slot, size_t expected)
+	{
+		size_t sequence = slot.sequence.load(std::memory_order_acquire);
+		for (int spin = 0; sequence != expected; spin++) {
+			if (spin >= MPMC_QUEUE_SPIN_COUNT) {
+				#if MPMC_QUEUE_FUTEX_WAIT == true
+				slot.sequence.wait(sequence, std::memory_order_acquire);
+				#else
+				std::this_thread::yield();
+				#endif
+			}
+			sequence = slot.sequence.load(std::memory_order_acquire);
+		}
+	}
+
+	/* Publish a slot's new sequence, waking any blocking push or pop waiting on it. */
+	static void SetSequence(Slot& slot, size_t sequence)
+	{
+		slot.sequence.store(sequence, std::memory_order_release);
+		#if MPMC_QUEUE_FUTEX_WAIT == true
+		slot.sequence.notify_all();
+		#endif
+	}
+
+	/* Claim a slot to push to, if the queue is not full. */
+	Slot* TryClaimPush(size_t& outPos)
+	{
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		while (true) {
+			Slot& slot = slots[ArrInt(pos & indexMask)];
+			const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			const intptr_t difference = intptr_t(sequence) - intptr_t(pos);
+			if (difference == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					outPos = pos;
+					return &slot;
+				}
+			}
+			else if (difference < 0) {
+				// The slot still holds the element from the previous lap.
+				return nullptr;
+			}
+			else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/* Claim a slot to pop from, if the queue is not empty. */
+	Slot* TryClaimPop(size_t& outPos)
+	{
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		while (true) {
+			Slot& slot = slots[ArrInt(pos & indexMask)];
+			const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			const intptr_t difference = intptr_t(sequence) - intptr_t(pos + 1);
+			if (difference == 0) {
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					outPos = pos;
+					return &slot;
+				}
+			}
+			else if (difference < 0) {
+				// The slot's element for this lap hasn't been pushed yet.
+				return nullptr;
+			}
+			else {
+				pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/* Take a ticket for the next push, and wait for it's slot to be free. */
+	Slot& ClaimPush(size_t& outPos)
+	{
+		outPos = enqueuePos.fetch_add(1, std::memory_order_relaxed);
+		Slot& slot = slots[ArrInt(outPos & indexMask)];
+		WaitForSequence(slot, outPos);
+		return slot;
+	}
+
+	/* Take a ticket for the next pop, and wait for it's slot to be filled. */
+	Slot& ClaimPop(size_t& outPos)
+	{
+		outPos = dequeuePos.fetch_add(1, std::memory_order_relaxed);
+		Slot& slot = slots[ArrInt(outPos & indexMask)];
+		WaitForSequence(slot, outPos + 1);
+		return slot;
+	}
+
+public:
+
+	/* Construct an empty queue.
+	@param capacity: Amount of slots, rounded up to a power of 2. At least 2. */
+	explicit mpmc_queue(size_t capacity)
+	{
+		capacity = capacity < 2 ? 2 : std::bit_ceil(capacity);
+		if (capacity > ARRAY_MAX_CAPACITY) {
+			_ArrayError("mpmc_queue capacity exceeds the array size type.");
+			abort();
+		}
+		indexMask = capacity - 1;
+		slots.Reserve(ArrInt(capacity));
+		for (size_t i = 0; i < capacity; i++) {
+			slots.Emplace(i);
+		}
+		enqueuePos.store(0, std::memory_order_relaxed);
+		dequeuePos.store(0, std::memory_order_relaxed);
+	}
+
+	mpmc_queue(const mpmc_queue&) = delete;
+	void operator = (const mpmc_queue&) = delete;
+
+	/* Get the amount of slots. */
+	size_t Capacity() const { return indexMask + 1; }
+
+	/* Get the amount of stored elements. Only approximate while other threads are pushing or popping. */
+	size_t Size() const
+	{
+		const size_t pushed = enqueuePos.load(std::memory_order_acquire);
+		const size_t popped = dequeuePos.load(std::memory_order_acquire);
+		return pushed > popped ? pushed - popped : 0;
+	}
+
+	/* Push an element by const ref, without blocking.
+	@returns If the element was pushed. False if the queue is full. */
+	bool TryPush(const T& value)
+	{
+		size_t pos;
+		Slot* slot = TryClaimPush(pos);
+		if (slot == nullptr) {
+			return false;
+		}
+		slot->value = value;
+		SetSequence(*slot, pos + 1);
+		return true;
+	}
+
+	/* Push an element by r value reference, without blocking.
+	@returns If the element was pushed. False if the queue is full, in which case the value is not moved from. */
+	bool TryPush(T&& value)
+	{
+		size_t pos;
+		Slot* slot = TryClaimPush(pos);
+		if (slot == nullptr) {
+			return false;
+		}
+		slot->value = std::move(value);
+		SetSequence(*slot, pos + 1);
+		return true;
+	}
+
+	/* Pop the oldest element, without blocking.
+	@param outValue: Set to the popped element.
+	@returns If an element was popped. False if the queue is empty. */
+	bool TryPop(T& outValue)
+	{
+		size_t pos;
+		Slot* slot = TryClaimPop(pos);
+		if (slot == nullptr) {
+			return false;
+		}
+		outValue = std::move(slot->value);
+		SetSequence(*slot, pos + Capacity());
+		return true;
+	}
+
+	/* Push an element by const ref, waiting for a free slot if the queue is full. */
+	void Push(const T& value)
+	{
+		size_t pos;
+		Slot& slot = ClaimPush(pos);
+		slot.value = value;
+		SetSequence(slot, pos + 1);
+	}
+
+	/* Push an element by r value reference, waiting for a free slot if the queue is full. */
+	void Push(T&& value)
+	{
+		size_t pos;
+		Slot& slot = ClaimPush(pos);
+		slot.value = std::move(value);
+		SetSequence(slot, pos + 1);
+	}
+
+	/* Pop the oldest element, waiting for one to be pushed if the queue is empty.
+	@param outValue: Set to the popped element. */
+	void Pop(T& outValue)
+	{
+		size_t pos;
+		Slot& slot = ClaimPop(pos);
+		outValue = std::move(slot.value);
+		SetSequence(slot, pos + Capacity());
+	}
+};
@@ -0,0 +1,123 @@
+#include "SpscRing.h"
+#include <string>
+#include <thread>
+#include <types/test/UnitTest.h>
+
+#if RUNTIME_UNIT_TESTS == true
+namespace SpscRingRuntimeUnitTests
+{
+	/* Pushes and pops stop at the full and empty edges, and spans split around the end of the slots keep their order. */
+	static void SpscEdgeTests()
+	{
+		spsc_ring<int, 8> ring;
+		int value = -1;
+		int values[16] = {};
+		RUNTIME_TEST_ASSERT(ring.Size() == 0 && !ring.TryPop(value) && value == -1 && ring.PopN(values, 16) == 0);
+
+		for (int i = 0; i < 8; i++) {
+			RUNTIME_TEST_ASSERT(ring.TryPush(i));
+		}
+		RUNTIME_TEST_ASSERT(ring.Size() == 8 && !ring.TryPush(8) && ring.PushN(values, 4) == 0);
+		for (int i = 0; i < 8; i++) {
+			RUNTIME_TEST_ASSERT(ring.TryPop(value) && value == i);
+		}
+		RUNTIME_TEST_ASSERT(ring.Size() == 0 && !ring.TryPop(value));
+
+		// The next push starts at slot 0 again, then the head and tail are moved to the middle of the slots.
+		for (int round = 0; round < 3; round++) {
+			RUNTIME_TEST_ASSERT(ring.PushN(values, 5) == 5 && ring.PopN(values, 5) == 5);
+		}
+
+		// Only the free slots are pushed, wrapping past the end.
+		int source[10];
+		for (int i = 0; i < 10; i++) {
+			source[i] = 100 + i;
+		}
+		RUNTIME_TEST_ASSERT(ring.TryPush(99));
+		RUNTIME_TEST_ASSERT(ring.PushN(source, 10) == 7 && ring.Size() == 8 && !ring.TryPush(0));
+
+		// Pops wrapping past the end, stopping at the stored elements.
+		RUNTIME_TEST_ASSERT(ring.TryPop(value) && value == 99);
+		RUNTIME_TEST_ASSERT(ring.PopN(values, 3) == 3 && values[0] == 100 && values[2] == 102);
+		RUNTIME_TEST_ASSERT(ring.PopN(values, 16) == 4 && values[0] == 103 && values[3] == 106);
+		RUNTIME_TEST_ASSERT(ring.Size() == 0 && ring.PopN(values, 16) == 0);
+
+		// Elements that aren't trivially copyable are moved out, and a failed push doesn't move from the value.
+		spsc_ring<std::string, 2> strings;
+		std::string first(40, 'a');
+		RUNTIME_TEST_ASSERT(strings.TryPush(std::move(first)) && first.empty());
+		const std::string batch[] = { std::string(40, 'b'), std::string(40, 'c') };
+		RUNTIME_TEST_ASSERT(strings.PushN(batch, 2) == 1 && batch[1] == std::string(40, 'c'));
+		std::string rejected(40, 'd');
+		RUNTIME_TEST_ASSERT(!strings.TryPush(std::move(rejected)) && rejected == std::string(40, 'd'));
+		std::string popped[2];
+		RUNTIME_TEST_ASSERT(strings.PopN(popped, 2) == 2 && popped[0] == std::string(40, 'a') && popped[1] == std::string(40, 'b'));
+		RUNTIME_TEST_ASSERT(strings.PushN(batch, 2) == 2 && strings.TryPop(popped[0]) && popped[0] == std::string(40, 'b'));
+	}
+	RUNTIME_TEST_SUITE(SpscEdgeTests);
+
+	constexpr int THREADED_COUNT = 200000;
+
+	/* A producer pushing single elements and batches, and a consumer popping single elements and batches, on their own threads,
+	see every element exactly once and in order, across many wraps of the slots. */
+	static void SpscThreadTests()
+	{
+		spsc_ring<int, 64> ring;
+		std::thread producer([&ring]() {
+			int next = 0;
+			int batch[48];
+			while (next < THREADED_COUNT) {
+				if (next % 3 == 0) {
+					if (ring.TryPush(next)) {
+						next++;
+					}
+					else {
+						std::this_thread::yield();
+					}
+					continue;
+				}
+				const int amount = std::min(1 + next % 47, THREADED_COUNT - next);
+				for (int i = 0; i < amount; i++) {
+					batch[i] = next + i;
+				}
+				const size_t pushed = ring.PushN(batch, size_t(amount));
+				if (pushed == 0) {
+					std::this_thread::yield();
+				}
+				next += int(pushed);
+			}
+		});
+
+		int expected = 0;
+		bool inOrder = true;
+		int batch[32];
+		while (expected < THREADED_COUNT) {
+			if (expected % 2 == 0) {
+				int value;
+				if (ring.TryPop(value)) {
+					inOrder &= value == expected;
+					expected++;
+				}
+				else {
+					std::this_thread::yield();
+				}
+				continue;
+			}
+			const size_t popped = ring.PopN(batch, 1 + expected % 32);
+			if (popped == 0) {
+				std::this_thread::yield();
+			}
+			for (size_t i = 0; i < popped; i++) {
+				inOrder &= batch[i] == expected;
+				expected++;
+			}
+		}
+		producer.join();
+
+		int value;
+		RUNTIME_TEST_ASSERT(inOrder && expected == THREADED_COUNT);
+		RUNTIME_TEST_ASSERT(ring.Size() == 0 && !ring.TryPop(value));
+	}
+	RUNTIME_TEST_SUITE(SpscThreadTests);
+}
+#endif
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <algorithm>
+#include <types/array/StaticArray.h>
+
+/*
+Lock free bounded queue between exactly one producer thread and one consumer thread, stored in a fixed sarray of N slots.
+The producer only writes the tail index and the consumer only writes the head index, each on it's own cache line,
+and each side keeps a cached copy of the other's index so it only reads the shared line when the ring looks full or empty.
+Indices are published with release stores and read with acquire loads, so a slot's contents are visible before it's index is.
+Slots are assigned into, so T must be default constructible and assignable. Trivially copyable types make PushN() and PopN() plain block copies.
+
+@param - T: Type the ring contains
+@param - N: Amount of slots. Must be a power of 2.
+*/
+template<typename T, size_t N>
+struct spsc_ring
+{
+	static_assert(std::has_single_bit(N), "spsc_ring capacity must be a power of 2");
+
+private:
+
+	static constexpr size_t INDEX_MASK = N - 1;
+
+	/* Index of the next slot to pop. Only written by the consumer. */
+	alignas(64) std::atomic<size_t> head;
+
+	/* Consumer's last seen tail, so it only reads the producer's line when the ring looks empty. */
+	size_t cachedTail;
+
+	/* Index of the next slot to push. Only written by the producer. */
+	alignas(64) std::atomic<size_t> tail;
+
+	/* Producer's last seen head, so it only reads the consumer's line when the ring looks full. */
+	size_t cachedHead;
+
+	alignas(64) sarray<T, N> slots;
+
+	/* Amount of free slots as seen by the producer, refreshing the cached head if needed to fit a requested amount. */
+	size_t FreeSlots(size_t currentTail, size_t wanted)
+	{
+		size_t available = N - (currentTail - cachedHead);
+		if (available < wanted) {
+			cachedHead = head.load(std::memory_order_acquire);
+			available = N - (currentTail - cachedHead);
+		}
+		return available;
+	}
+
+	/* Amount of filled slots as seen by the consumer, refreshing the cached tail if needed to fit a requested amount. */
+	size_t FilledSlots(size_t currentHead, size_t wanted)
+	{
+		size_t available = cachedTail - currentHead;
+		if (available < wanted) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			available = cachedTail - currentHead;
+		}
+		return available;
+	}
+
+public:
+
+	/* Construct an empty ring. */
+	spsc_ring()
+	{
+		head.store(0, std::memory_order_relaxed);
+		cachedTail = 0;
+		tail.store(0, std::memory_order_relaxed);
+		cachedHead = 0;
+	}
+
+	spsc_ring(const spsc_ring&) = delete;
+	void operator = (const spsc_ring&) = delete;
+
+	/* Get the amount of slots. */
+	static constexpr size_t Capacity() { return N; }
+
+	/* Get the amount of stored elements. Only exact when called from the producer or consumer while the other is idle. */
+	size_t Size() const
+	{
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+	/* Push an element by const ref. Producer only.
+	@returns If the element was pushed. False if the ring is full. */
+	bool TryPush(const T& value)
+	{
+		const size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (FreeSlots(currentTail, 1) == 0) {
+			return false;
+		}
+		slots.GetData()[currentTail & INDEX_MASK] = value;
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* Push an element by r value reference. Producer only.
+	@returns If the element was pushed. False if the ring is full, in which case the value is not moved from. */
+	bool TryPush(T&& value)
+	{
+		const size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (FreeSlots(currentTail, 1) == 0) {
+			return false;
+		}
+		slots.GetData()[currentTail & INDEX_MASK] = std::move(value);
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* Pop the oldest element. Consumer only.
+	@param outValue: Set to the popped element.
+	@returns If an element was popped. False if the ring is empty. */
+	bool TryPop(T& outValue)
+	{
+		const size_t currentHead = head.load(std::memory_order_relaxed);
+		if (FilledSlots(currentHead, 1) == 0) {
+			return false;
+		}
+		outValue = std::move(slots.GetData()[currentHead & INDEX_MASK]);
+		head.store(currentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* Push as many elements as fit, copying them in at most two contiguous spans, and publishing them all at once. Producer only.
+	@param values: Pointer to an array of T value(s).
+	@param count: Amount of T's to push.
+	@returns Amount of elements pushed. Less than count if the ring filled up. */
+	size_t PushN(const T* values, size_t count)
+	{
+		const size_t currentTail = tail.load(std::memory_order_relaxed);
+		const size_t available = FreeSlots(currentTail, count);
+		const size_t amount = count < available ? count : available;
+		if (amount == 0) {
+			return 0;
+		}
+
+		T* data = slots.GetData();
+		const size_t start = currentTail & INDEX_MASK;
+		const size_t firstSpan = N - start < amount ? N - start : amount;
+		std::copy_n(values, firstSpan, data + start);
+		std::copy_n(values + firstSpan, amount - firstSpan, data);
+		tail.store(currentTail + amount, std::memory_order_release);
+		return amount;
+	}
+
+	/* Pop up to a maximum amount of the oldest elements, moving them out in at most two contiguous spans, and releasing their slots all at once. Consumer only.
+	@param outValues: Pointer to an array of at least count T's to move the popped elements to.
+	@param count: Max amount of T's to pop.
+	@returns Amount of elements popped. */
+	size_t PopN(T* outValues, size_t count)
+	{
+		const size_t currentHead = head.load(std::memory_order_relaxed);
+		const size_t available = FilledSlots(currentHead, count);
+		const size_t amount = count < available ? count : available;
+		if (amount == 0) {
+			return 0;
+		}
+
+		T* data = slots.GetData();
+		const size_t start = currentHead & INDEX_MASK;
+		const size_t firstSpan = N - start < amount ? N - start : amount;
+		std::move(data + start, data + start + firstSpan, outValues);
+		std::move(data, data + (amount - firstSpan), outValues + firstSpan);
+		head.store(currentHead + amount, std::memory_order_release);
+		return amount;
+	}
+};
@@ -0,0 +1,457 @@
+#include "Serialization.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <types/test/UnitTest.h>
+
+/* Start of every serialized buffer. */
+struct SerializedStreamHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t reserved;
+};
+
+static constexpr size_t AlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+BinaryWriter::BinaryWriter()
+{
+	const SerializedStreamHeader header = { SERIALIZATION_MAGIC, SERIALIZATION_VERSION, 0 };
+	WriteBytes(&header, sizeof(header));
+}
+
+void BinaryWriter::WriteBytes(const void* bytes, size_t count)
+{
+	if (count > 0) {
+		buffer.InsertElements(static_cast<const char*>(bytes), ArrInt(count));
+	}
+}
+
+void BinaryWriter::Align(size_t alignment)
+{
+	static const char zeros[64] = {};
+	size_t padding = AlignUp(buffer.Size(), alignment) - buffer.Size();
+	while (padding > 0) {
+		const size_t amount = padding < sizeof(zeros) ? padding : sizeof(zeros);
+		WriteBytes(zeros, amount);
+		padding -= amount;
+	}
+}
+
+void BinaryWriter::BeginRecord(SerializedType type, uint32_t elementSize, uint64_t count, size_t dataAlignment)
+{
+	Align(SERIALIZATION_RECORD_ALIGNMENT);
+	const SerializedRecordHeader header = { type, elementSize, count };
+	WriteBytes(&header, sizeof(header));
+	Align(dataAlignment);
+}
+
+void BinaryWriter::WriteString(const char* chars, size_t length)
+{
+	BeginRecord(SerializedType::String, 1, length, 1);
+	WriteBytes(chars, length);
+	const char terminator = '\0';
+	WriteBytes(&terminator, 1);
+	Align(SERIALIZATION_RECORD_ALIGNMENT);
+}
+
+void BinaryWriter::Write(const String& string)
+{
+	WriteString(string.CString(), string.Length());
+}
+
+void BinaryWriter::Write(const SString& string)
+{
+	WriteString(string.CStr(), string.Length());
+}
+
+bool BinaryWriter::SaveToFile(const char* path) const
+{
+	MappedFile file;
+	if (!file.Open(path, false) || !file.Resize(buffer.Size())) {
+		return false;
+	}
+	memcpy(file.Data(), buffer.GetData(), buffer.Size());
+	return file.Flush();
+}
+
+BinaryReader::BinaryReader(const void* bytes, size_t byteCount)
+{
+	data = static_cast<const char*>(bytes);
+	size = byteCount;
+	offset = sizeof(SerializedStreamHeader);
+	valid = true;
+
+	SerializedStreamHeader header;
+	if (data == nullptr || size < sizeof(header)) {
+		Fail();
+		return;
+	}
+	memcpy(&header, data, sizeof(header));
+	if (header.magic != SERIALIZATION_MAGIC || header.version != SERIALIZATION_VERSION) {
+		Fail();
+	}
+}
+
+BinaryReader::BinaryReader(const MappedFile& file)
+	: BinaryReader(file.Data(), file.Size())
+{
+}
+
+bool BinaryReader::Fail()
+{
+	valid = false;
+	offset = size;
+	return false;
+}
+
+bool BinaryReader::PeekRecord(SerializedRecordHeader& outHeader) const
+{
+	const size_t start = AlignUp(offset, SERIALIZATION_RECORD_ALIGNMENT);
+	if (!valid || start > size || size - start < sizeof(SerializedRecordHeader)) {
+		return false;
+	}
+	memcpy(&outHeader, data + start, sizeof(outHeader));
+	return true;
+}
+
+const char* BinaryReader::BeginRecord(SerializedType type, uint32_t elementSize, size_t dataAlignment, uint64_t& outCount)
+{
+	SerializedRecordHeader header;
+	if (!PeekRecord(header) || header.type != type || header.elementSize != elementSize) {
+		Fail();
+		return nullptr;
+	}
+
+	const size_t dataOffset = AlignUp(AlignUp(offset, SERIALIZATION_RECORD_ALIGNMENT) + sizeof(header), dataAlignment);
+	const size_t available = dataOffset <= size ? size - dataOffset : 0;
+
+	// The elements must fit in the buffer, and in the array size type. Strings are followed by their null terminator.
+	// Bitsets count bits, and their element size is the size of all of them.
+	const uint64_t bytes = elementSize == 0 ? 0 : header.count * elementSize;
+	const bool fits = type == SerializedType::Bitset ? elementSize <= available : (elementSize == 0 || header.count <= available / elementSize);
+	if (dataOffset > size
+		|| header.count > ARRAY_MAX_CAPACITY
+		|| !fits
+		|| (type == SerializedType::String && bytes >= available)) {
+		Fail();
+		return nullptr;
+	}
+
+	const char* recordData = data + dataOffset;
+	if (reinterpret_cast<uintptr_t>(recordData) % dataAlignment != 0) {
+		Fail();
+		return nullptr;
+	}
+
+	outCount = header.count;
+	offset = dataOffset;
+	return recordData;
+}
+
+void BinaryReader::EndRecord(const char* recordData, size_t bytes)
+{
+	offset = AlignUp(size_t(recordData - data) + bytes, SERIALIZATION_RECORD_ALIGNMENT);
+}
+
+array_view<char> BinaryReader::ReadStringView()
+{
+	uint64_t length;
+	const char* recordData = BeginRecord(SerializedType::String, 1, 1, length);
+	if (recordData == nullptr) {
+		return array_view<char>();
+	}
+	if (recordData[length] != '\0') {
+		Fail();
+		return array_view<char>();
+	}
+	EndRecord(recordData, length + 1);
+	return array_view<char>(recordData, ArrInt(length));
+}
+
+bool BinaryReader::Read(String& outString)
+{
+	const array_view<char> view = ReadStringView();
+	if (!valid) {
+		return false;
+	}
+	outString = String(view.data, view.Size());
+	return true;
+}
+
+bool BinaryReader::Read(SString& outString)
+{
+	const array_view<char> view = ReadStringView();
+	if (!valid) {
+		return false;
+	}
+	outString = SString(view.data, view.Size());
+	return true;
+}
+
+#if RUNTIME_UNIT_TESTS == true
+namespace SerializationRuntimeUnitTests
+{
+	struct Point
+	{
+		int x;
+		int y;
+	};
+
+	static ArrInt HashPointKey(const int& key)
+	{
+		return ArrInt(key) * 2654435761u;
+	}
+
+	static String Number(int value)
+	{
+		return String(std::to_string(value).c_str());
+	}
+
+	/* Find the value of a key in a map, or nullptr. */
+	template<typename K, typename V, ArrInt(*MapHasher)(const K&)>
+	static V* FindInMap(Map<K, V, MapHasher>& map, const K& key)
+	{
+		return map.buckets[Map<K, V, MapHasher>::GetBucketForKey(map.bucketCount, key)].Find(key);
+	}
+
+	/* Every record kind reads back what was written, in order, both as copies and as views into the buffer. */
+	static void SerializationRoundTripTests()
+	{
+		darray<int> ints;
+		for (int i = 0; i < 100; i++) {
+			ints.Add(i * 3 - 50);
+		}
+		sarray<double, 4> doubles;
+		doubles[0] = 1.5; doubles[1] = -2.0; doubles[2] = 0.0; doubles[3] = 1e300;
+		const char embedded[] = "ab\0cd\0";
+		const String longString = "a string that is far too long to be stored inline";
+		const SString smallString = "small";
+		const String nulls(embedded, sizeof(embedded) - 1);
+		const char longEmbedded[] = "a string long enough for the heap\0with a null in it";
+		const SString longNulls(longEmbedded, sizeof(longEmbedded) - 1);
+		bitset<130> bits;
+		bits.SetBit(0); bits.SetBit(64); bits.SetBit(129);
+		Map<int, Point, HashPointKey> points;
+		for (int i = 0; i < 50; i++) {
+			points.Add(i, Point{ i, i * i });
+		}
+		Map<String, String, HashString> names;
+		names.Add(String("short"), String("value"));
+		names.Add(String("a key that is long enough to be on the heap"), nulls);
+		for (int i = 0; i < 30; i++) {
+			names.Add(Number(i), Number(i * 7));
+		}
+
+		BinaryWriter writer;
+		writer.Write(ints);
+		writer.Write(doubles);
+		writer.Write(Point{ 7, -7 });
+		writer.Write(longString);
+		writer.Write(smallString);
+		writer.Write(nulls);
+		writer.Write(longNulls);
+		writer.Write(longNulls);
+		writer.WriteArray<int>(nullptr, 0);
+		writer.Write(bits);
+		writer.Write(points);
+		writer.Write(names);
+
+		BinaryReader reader(writer.GetBuffer().GetData(), writer.GetBuffer().Size());
+		RUNTIME_TEST_ASSERT(reader.IsValid() && !reader.IsAtEnd());
+
+		darray<int> readInts;
+		readInts.Add(-1);
+		RUNTIME_TEST_ASSERT(reader.Read(readInts));
+		RUNTIME_TEST_ASSERT(readInts.Size() == 101 && readInts[0] == -1);
+		RUNTIME_TEST_ASSERT(memcmp(readInts.GetData() + 1, ints.GetData(), sizeof(int) * 100) == 0);
+
+		sarray<double, 4> readDoubles;
+		RUNTIME_TEST_ASSERT(reader.Read(readDoubles));
+		RUNTIME_TEST_ASSERT(readDoubles[0] == 1.5 && readDoubles[1] == -2.0 && readDoubles[3] == 1e300);
+
+		Point point = {};
+		RUNTIME_TEST_ASSERT(reader.Read(point) && point.x == 7 && point.y == -7);
+
+		String readLong;
+		RUNTIME_TEST_ASSERT(reader.Read(readLong) && readLong == longString);
+		SString readSmall;
+		RUNTIME_TEST_ASSERT(reader.Read(readSmall) && readSmall.View() == smallString.View());
+
+		// Null characters within strings are kept.
+		String readNulls;
+		RUNTIME_TEST_ASSERT(reader.Read(readNulls) && readNulls.Length() == 6 && readNulls == nulls);
+		SString readLongNulls;
+		RUNTIME_TEST_ASSERT(reader.Read(readLongNulls) && readLongNulls.View() == longNulls.View());
+		RUNTIME_TEST_ASSERT(!readLongNulls.IsSmallString() && readLongNulls.Length() == sizeof(longEmbedded) - 1);
+		const array_view<char> nullsView = reader.ReadStringView();
+		RUNTIME_TEST_ASSERT(nullsView.Size() == sizeof(longEmbedded) - 1 && memcmp(nullsView.data, longEmbedded, sizeof(longEmbedded)) == 0);
+
+		const array_view<int> empty = reader.ReadArrayView<int>();
+		RUNTIME_TEST_ASSERT(reader.IsValid() && empty.Size() == 0);
+
+		bitset<130> readBits;
+		RUNTIME_TEST_ASSERT(reader.Read(readBits));
+		RUNTIME_TEST_ASSERT(readBits.GetBit(0) && readBits.GetBit(64) && readBits.GetBit(129) && !readBits.GetBit(1) && !readBits.GetBit(128));
+
+		// Trivially copyable pairs are one array of pairs.
+		Map<int, Point, HashPointKey> readPoints;
+		RUNTIME_TEST_ASSERT(reader.Read(readPoints));
+		RUNTIME_TEST_ASSERT(readPoints.elementCount == 50);
+		for (int i = 0; i < 50; i++) {
+			const Point* found = FindInMap(readPoints, i);
+			RUNTIME_TEST_ASSERT(found != nullptr && found->x == i && found->y == i * i);
+		}
+
+		// Other pairs are individual key and value records.
+		Map<String, String, HashString> readNames;
+		RUNTIME_TEST_ASSERT(reader.Read(readNames));
+		RUNTIME_TEST_ASSERT(readNames.elementCount == 32);
+		const String* shortValue = FindInMap(readNames, String("short"));
+		RUNTIME_TEST_ASSERT(shortValue != nullptr && *shortValue == String("value"));
+		const String* nullsValue = FindInMap(readNames, String("a key that is long enough to be on the heap"));
+		RUNTIME_TEST_ASSERT(nullsValue != nullptr && *nullsValue == nulls);
+		for (int i = 0; i < 30; i++) {
+			const String* value = FindInMap(readNames, Number(i));
+			RUNTIME_TEST_ASSERT(value != nullptr && *value == Number(i * 7));
+		}
+
+		RUNTIME_TEST_ASSERT(reader.IsValid() && reader.IsAtEnd());
+
+		// Reading past the end fails, rather than reading garbage.
+		int extra = 0;
+		RUNTIME_TEST_ASSERT(!reader.Read(extra) && !reader.IsValid());
+	}
+
+	/* The same stream, written to a file, reads back in place from it's mapping. */
+	static void SerializationFileTests()
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "serialization_file.bin").string();
+		std::remove(path.c_str());
+
+		BinaryWriter writer;
+		writer.Write(Point{ 1, 2 });
+		writer.Write(String("mapped"));
+		RUNTIME_TEST_ASSERT(writer.SaveToFile(path.c_str()));
+
+		MappedFile file;
+		RUNTIME_TEST_ASSERT(file.Open(path.c_str(), true));
+		BinaryReader reader(file);
+		const array_view<Point> points = reader.ReadArrayView<Point>();
+		RUNTIME_TEST_ASSERT(points.Size() == 1 && points[0].x == 1 && points[0].y == 2);
+		RUNTIME_TEST_ASSERT(StringView(reader.ReadStringView().data) == StringView("mapped"));
+		RUNTIME_TEST_ASSERT(reader.IsValid() && reader.IsAtEnd());
+		file.Close();
+		std::remove(path.c_str());
+	}
+
+	/* Copy of a buffer, with a value overwritten at an offset. */
+	template<typename T>
+	static darray<char> Corrupt(const darray<char>& buffer, size_t offset, const T& value)
+	{
+		darray<char> corrupted = buffer;
+		memcpy(corrupted.GetData() + offset, &value, sizeof(value));
+		return corrupted;
+	}
+
+	/* Malformed buffers and mismatched reads fail without aborting, and leave the reader invalid. */
+	static void SerializationMalformedTests()
+	{
+		// Stream header, then each record header, then the record's data.
+		constexpr size_t RECORD = sizeof(SerializedStreamHeader);
+		constexpr size_t RECORD_DATA = RECORD + sizeof(SerializedRecordHeader);
+
+		BinaryWriter writer;
+		const int values[] = { 1, 2, 3, 4 };
+		writer.WriteArray(values, 4);
+		const darray<char>& buffer = writer.GetBuffer();
+		RUNTIME_TEST_ASSERT(BinaryReader(buffer.GetData(), buffer.Size()).ReadArrayView<int>().Size() == 4);
+
+		// Missing or wrong stream header.
+		RUNTIME_TEST_ASSERT(!BinaryReader(nullptr, 0).IsValid());
+		RUNTIME_TEST_ASSERT(!BinaryReader(buffer.GetData(), RECORD - 1).IsValid());
+		const darray<char> badMagic = Corrupt(buffer, 0, SERIALIZATION_MAGIC + 1);
+		RUNTIME_TEST_ASSERT(!BinaryReader(badMagic.GetData(), badMagic.Size()).IsValid());
+		const darray<char> badVersion = Corrupt(buffer, sizeof(uint32_t), SERIALIZATION_VERSION + 1);
+		RUNTIME_TEST_ASSERT(!BinaryReader(badVersion.GetData(), badVersion.Size()).IsValid());
+
+		// Reads on an invalid reader fail.
+		BinaryReader invalid(badMagic.GetData(), badMagic.Size());
+		darray<int> out;
+		RUNTIME_TEST_ASSERT(!invalid.Read(out) && out.Size() == 0);
+
+		// Truncated records.
+		for (size_t size : { RECORD + 4, RECORD_DATA, RECORD_DATA + sizeof(int) * 3 }) {
+			BinaryReader truncated(buffer.GetData(), size);
+			RUNTIME_TEST_ASSERT(truncated.IsValid());
+			RUNTIME_TEST_ASSERT(truncated.ReadArrayView<int>().Size() == 0 && !truncated.IsValid());
+		}
+
+		// Counts too large for the buffer, including ones that overflow when multiplied by the element size.
+		for (uint64_t count : { uint64_t(5), uint64_t(-1), uint64_t(-1) / 4 + 1 }) {
+			const darray<char> huge = Corrupt(buffer, RECORD + 2 * sizeof(uint32_t), count);
+			BinaryReader reader(huge.GetData(), huge.Size());
+			RUNTIME_TEST_ASSERT(reader.ReadArrayView<int>().Size() == 0 && !reader.IsValid());
+		}
+
+		// Wrong record kind and element size.
+		{
+			BinaryReader reader(buffer.GetData(), buffer.Size());
+			String string;
+			RUNTIME_TEST_ASSERT(!reader.Read(string) && !reader.IsValid());
+			RUNTIME_TEST_ASSERT(!reader.Read(out) && out.Size() == 0);
+		}
+		{
+			BinaryReader reader(buffer.GetData(), buffer.Size());
+			RUNTIME_TEST_ASSERT(reader.ReadArrayView<long long>().Size() == 0 && !reader.IsValid());
+		}
+		{
+			BinaryReader reader(buffer.GetData(), buffer.Size());
+			bitset<128> bits;
+			RUNTIME_TEST_ASSERT(!reader.Read(bits) && !reader.IsValid());
+		}
+		{
+			BinaryReader reader(buffer.GetData(), buffer.Size());
+			int single = 0;
+			RUNTIME_TEST_ASSERT(!reader.Read(single) && !reader.IsValid());
+		}
+		{
+			BinaryReader reader(buffer.GetData(), buffer.Size());
+			sarray<int, 3> fixed;
+			RUNTIME_TEST_ASSERT(!reader.Read(fixed) && !reader.IsValid());
+		}
+
+		// Strings must be followed by their null terminator.
+		BinaryWriter stringWriter;
+		stringWriter.Write(String("text"));
+		const darray<char> unterminated = Corrupt(stringWriter.GetBuffer(), RECORD_DATA + 4, 'x');
+		BinaryReader unterminatedReader(unterminated.GetData(), unterminated.Size());
+		RUNTIME_TEST_ASSERT(unterminatedReader.ReadStringView().Size() == 0 && !unterminatedReader.IsValid());
+
+		// Bitsets of a different size.
+		BinaryWriter bitsWriter;
+		bitsWriter.Write(bitset<100>());
+		BinaryReader bitsReader(bitsWriter.GetBuffer().GetData(), bitsWriter.GetBuffer().Size());
+		bitset<120> wrongBits;
+		RUNTIME_TEST_ASSERT(!bitsReader.Read(wrongBits) && !bitsReader.IsValid());
+		BinaryReader truncatedBitsReader(bitsWriter.GetBuffer().GetData(), bitsWriter.GetBuffer().Size() - 1);
+		bitset<100> truncatedBits;
+		RUNTIME_TEST_ASSERT(!truncatedBitsReader.Read(truncatedBits) && !truncatedBitsReader.IsValid());
+
+		// Maps missing some of their pairs' records.
+		Map<String, String, HashString> names;
+		names.Add(String("key"), String("value"));
+		BinaryWriter mapWriter;
+		mapWriter.Write(names);
+		BinaryReader mapReader(mapWriter.GetBuffer().GetData(), mapWriter.GetBuffer().Size() - SERIALIZATION_RECORD_ALIGNMENT);
+		Map<String, String, HashString> readNames;
+		RUNTIME_TEST_ASSERT(!mapReader.Read(readNames) && !mapReader.IsValid());
+	}
+	RUNTIME_TEST_SUITE(SerializationRoundTripTests);
+	RUNTIME_TEST_SUITE(SerializationFileTests);
+	RUNTIME_TEST_SUITE(SerializationMalformedTests);
+}
+#endif
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <cstdint>
+#include <types/array/DynamicArray.h>
+#include <types/array/StaticArray.h>
+#include <types/bitset/bitset.h>
+#include <types/map/Map.h>
+#include <types/string/String.h>
+#include <types/string/SString.h>
+#include <types/file/MappedFile.h>
+
+/* Identifies a buffer as serialized data. The bytes read "CDTB". */
+constexpr uint32_t SERIALIZATION_MAGIC = 0x42544443;
+
+/* Format version written by BinaryWriter. BinaryReader refuses buffers of a different version. */
+constexpr uint32_t SERIALIZATION_VERSION = 1;
+
+/* Every record starts on a multiple of this many bytes. */
+constexpr size_t SERIALIZATION_RECORD_ALIGNMENT = 8;
+
+/* Kind of value a record holds. */
+enum class SerializedType : uint32_t
+{
+	Array = 1,
+	String = 2,
+	Bitset = 3,
+	Map = 4,
+};
+
+/* Start of every record in a serialized buffer. The record's data follows, aligned to it's element type. */
+struct SerializedRecordHeader
+{
+	SerializedType type;
+
+	/* Size of each element in bytes. 0 for maps of non trivially copyable pairs, whose pairs are stored as individual records. */
+	uint32_t elementSize;
+
+	/* Amount of elements, characters, bits, or pairs. */
+	uint64_t count;
+};
+
+/* Read only view of elements stored in a serialized buffer, without copying them. Only valid while the buffer is.
+An invalid view (from a failed read) is empty. */
+template<typename T>
+struct array_view
+{
+	const T* data;
+	ArrInt count;
+
+	array_view() : data(nullptr), count(0) {}
+	array_view(const T* _data, ArrInt _count) : data(_data), count(_count) {}
+
+	ArrInt Size() const { return count; }
+
+	const T* begin() const { return data; }
+	const T* end() const { return data + count; }
+
+	/* Get a reference to an element at a specific index. Will only check if correct index if ARRAY_CHECK_OUT_OF_BOUNDS macro is set. */
+	const T& operator [] (ArrInt index) const
+	{
+		#if ARRAY_CHECK_OUT_OF_BOUNDS == true
+		if (index >= count) {
+			_ArrayError("Index out of bounds from array_view::operator[].");
+			abort();
+		}
+		#endif
+		return data[index];
+	}
+};
+
+/*
+Writes containers into a versioned binary buffer, which BinaryReader can read back in place from memory or a mapped file.
+Elements are stored as raw bytes, aligned for their type, so the buffer is only portable between machines with the same type layout and byte order.
+Arrays require trivially copyable element types. Maps of trivially copyable pairs are stored as a single pair array,
+and other maps as their individual keys and values.
+*/
+class BinaryWriter
+{
+private:
+
+	darray<char> buffer;
+
+	/* Pad the buffer with zeros up to a multiple of alignment. */
+	void Align(size_t alignment);
+
+	/* Write a record header, then pad so the record's data starts aligned. */
+	void BeginRecord(SerializedType type, uint32_t elementSize, uint64_t count, size_t dataAlignment);
+
+public:
+
+	/* Construct a buffer containing only the stream header. */
+	BinaryWriter();
+
+	/* Append raw bytes, without any record header or padding. */
+	void WriteBytes(const void* bytes, size_t count);
+
+	/* Write elements as an array record.
+	@param data: Pointer to the first element.
+	@param count: Amount of elements. */
+	template<typename T>
+	void WriteArray(const T* data, size_t count)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter can only write arrays of trivially copyable types");
+		BeginRecord(SerializedType::Array, sizeof(T), count, alignof(T));
+		WriteBytes(data, sizeof(T) * count);
+		Align(SERIALIZATION_RECORD_ALIGNMENT);
+	}
+
+	/* Write a single trivially copyable value, as an array record of 1 element. */
+	template<typename T>
+		requires std::is_trivially_copyable_v<T>
+	void Write(const T& value)
+	{
+		WriteArray(&value, 1);
+	}
+
+	template<typename T, darray_cap_inc capacityInc, typename Allocator>
+	void Write(const darray<T, capacityInc, Allocator>& arr)
+	{
+		WriteArray(arr.GetData(), arr.Size());
+	}
+
+	template<typename T, size_t N>
+	void Write(const sarray<T, N>& arr)
+	{
+		WriteArray(arr.GetData(), N);
+	}
+
+	/* Write a string record. The characters are followed by a null terminator, so views of them can be used as c strings. */
+	void WriteString(const char* chars, size_t length);
+
+	void Write(const String& string);
+
+	void Write(const SString& string);
+
+	template<unsigned int bitQuantity>
+	void Write(const bitset<bitQuantity>& bits)
+	{
+		BeginRecord(SerializedType::Bitset, sizeof(bits.bitsArray), bitQuantity, alignof(decltype(bits.bits)));
+		WriteBytes(bits.bitsArray, sizeof(bits.bitsArray));
+		Align(SERIALIZATION_RECORD_ALIGNMENT);
+	}
+
+	template<typename K, typename V, ArrInt(*MapHasher)(const K&)>
+	void Write(const Map<K, V, MapHasher>& map)
+	{
+		const ArrInt bucketCount = map.buckets.Size();
+		const auto* buckets = map.buckets.GetData();
+		if constexpr (std::is_trivially_copyable_v<Pair<K, V>>) {
+			BeginRecord(SerializedType::Map, sizeof(Pair<K, V>), map.elementCount, alignof(Pair<K, V>));
+			for (ArrInt i = 0; i < bucketCount; i++) {
+				WriteBytes(buckets[i].elements.GetData(), sizeof(Pair<K, V>) * buckets[i].elements.Size());
+			}
+			Align(SERIALIZATION_RECORD_ALIGNMENT);
+		}
+		else {
+			BeginRecord(SerializedType::Map, 0, map.elementCount, SERIALIZATION_RECORD_ALIGNMENT);
+			for (ArrInt i = 0; i < bucketCount; i++) {
+				const Pair<K, V>* pairs = buckets[i].elements.GetData();
+				for (ArrInt p = 0; p < buckets[i].elements.Size(); p++) {
+					Write(pairs[p].key);
+					Write(pairs[p].value);
+				}
+			}
+		}
+	}
+
+	/* Get the serialized bytes. */
+	const darray<char>& GetBuffer() const { return buffer; }
+
+	/* Write the serialized bytes to a file, replacing it's contents.
+	@returns If the file was written and flushed. */
+	bool SaveToFile(const char* path) const;
+};
+
+/*
+Reads a buffer written by BinaryWriter, in the same order it was written. Array and string reads can return views into the buffer
+without copying or parsing any elements, so a mapped file can be used directly.
+Views require the buffer to be aligned for their element type. Mapped files and heap allocations always are for standard types.
+A malformed buffer or a mismatched read never aborts. The read returns false or an empty view, and the reader becomes invalid.
+Records are checked for their kind and element size, not the exact element type.
+*/
+class BinaryReader
+{
+private:
+
+	const char* data;
+
+	size_t size;
+
+	/* Offset of the next record. */
+	size_t offset;
+
+	bool valid;
+
+	/* Invalidate the reader. Always returns false. */
+	bool Fail();
+
+	/* Read the next record header and skip to the record's data, if it matches the expected type and element size.
+	@param outCount: Amount of elements in the record.
+	@param dataAlignment: Alignment of the record's data.
+	@returns Pointer to the record's data, or nullptr if the record doesn't match or exceeds the buffer. */
+	const char* BeginRecord(SerializedType type, uint32_t elementSize, size_t dataAlignment, uint64_t& outCount);
+
+	/* Skip past a record's data of a specified byte size, to the start of the next record. */
+	void EndRecord(const char* recordData, size_t bytes);
+
+	/* Read a record header without consuming it. */
+	bool PeekRecord(SerializedRecordHeader& outHeader) const;
+
+public:
+
+	/* Read from a buffer. The stream header is checked immediately. See IsValid(). */
+	BinaryReader(const void* bytes, size_t byteCount);
+
+	/* Read from a mapped file. The file must stay open while the reader and any of it's views are used. */
+	BinaryReader(const MappedFile& file);
+
+	/* Whether the buffer header was valid, and every read so far succeeded. */
+	bool IsValid() const { return valid; }
+
+	/* Whether every record has been read. */
+	bool IsAtEnd() const { return offset >= size; }
+
+	/* Read an array record as a view into the buffer, without copying.
+	@returns View of the elements, or an empty view if the next record is not an array of T. */
+	template<typename T>
+	array_view<T> ReadArrayView()
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "BinaryReader can only read arrays of trivially copyable types");
+		uint64_t count;
+		const char* recordData = BeginRecord(SerializedType::Array, sizeof(T), alignof(T), count);
+		if (recordData == nullptr) {
+			return array_view<T>();
+		}
+		EndRecord(recordData, sizeof(T) * count);
+		return array_view<T>(reinterpret_cast<const T*>(recordData), ArrInt(count));
+	}
+
+	/* Read a single value written with BinaryWriter::Write(const T&). */
+	template<typename T>
+		requires std::is_trivially_copyable_v<T>
+	bool Read(T& outValue)
+	{
+		const array_view<T> view = ReadArrayView<T>();
+		if (view.Size() != 1) {
+			return Fail();
+		}
+		outValue = view[0];
+		return true;
+	}
+
+	/* Read an array record, appending it's elements to an array with a single copy. */
+	template<typename T, darray_cap_inc capacityInc, typename Allocator>
+	bool Read(darray<T, capacityInc, Allocator>& outArray)
+	{
+		const array_view<T> view = ReadArrayView<T>();
+		if (!valid) {
+			return false;
+		}
+		outArray.InsertElements(view.data, view.Size());
+		return true;
+	}
+
+	/* Read an array record into a static array. The record must have exactly N elements. */
+	template<typename T, size_t N>
+	bool Read(sarray<T, N>& outArray)
+	{
+		const array_view<T> view = ReadArrayView<T>();
+		if (!valid || view.Size() != N) {
+			return Fail();
+		}
+		memcpy((void*)outArray.GetData(), (const void*)view.data, sizeof(T) * N);
+		return true;
+	}
+
+	/* Read a string record as a view into the buffer, without copying.
+	@returns View of the characters, excluding the null terminator that follows them, or an empty view if the next record is not a string. */
+	array_view<char> ReadStringView();
+
+	/* Read a string record into a string, including any null characters within it. */
+	bool Read(String& outString);
+
+	/* Read a string record into a string, including any null characters within it. */
+	bool Read(SString& outString);
+
+	template<unsigned int bitQuantity>
+	bool Read(bitset<bitQuantity>& outBits)
+	{
+		uint64_t count;
+		const char* recordData = BeginRecord(SerializedType::Bitset, sizeof(outBits.bitsArray), alignof(decltype(outBits.bits)), count);
+		if (recordData == nullptr || count != bitQuantity) {
+			return Fail();
+		}
+		memcpy(outBits.bitsArray, recordData, sizeof(outBits.bitsArray));
+		EndRecord(recordData, sizeof(outBits.bitsArray));
+		return true;
+	}
+
+	/* Read the pairs of a map of trivially copyable pairs as a view into the buffer, without copying or rehashing. */
+	template<typename K, typename V>
+	array_view<Pair<K, V>> ReadMapPairsView()
+	{
+		static_assert(std::is_trivially_copyable_v<Pair<K, V>>, "Only maps of trivially copyable pairs can be viewed without copying");
+		uint64_t count;
+		const char* recordData = BeginRecord(SerializedType::Map, sizeof(Pair<K, V>), alignof(Pair<K, V>), count);
+		if (recordData == nullptr) {
+			return array_view<Pair<K, V>>();
+		}
+		EndRecord(recordData, sizeof(Pair<K, V>) * count);
+		return array_view<Pair<K, V>>(reinterpret_cast<const Pair<K, V>*>(recordData), ArrInt(count));
+	}
+
+	/* Read a map record, adding every pair to a map. */
+	template<typename K, typename V, ArrInt(*MapHasher)(const K&)>
+	bool Read(Map<K, V, MapHasher>& outMap)
+	{
+		if constexpr (std::is_trivially_copyable_v<Pair<K, V>>) {
+			const array_view<Pair<K, V>> pairs = ReadMapPairsView<K, V>();
+			if (!valid) {
+				return false;
+			}
+			for (const Pair<K, V>& pair : pairs) {
+				outMap.Add(pair);
+			}
+			return true;
+		}
+		else {
+			uint64_t count;
+			const char* recordData = BeginRecord(SerializedType::Map, 0, SERIALIZATION_RECORD_ALIGNMENT, count);
+			if (recordData == nullptr) {
+				return false;
+			}
+			EndRecord(recordData, 0);
+			for (uint64_t i = 0; i < count; i++) {
+				Pair<K, V> pair;
+				if (!Read(pair.key) || !Read(pair.value)) {
+					return false;
+				}
+				outMap.Add(pair);
+			}
+			return true;
+		}
+	}
+};
@@ -0,0 +1,63 @@
+#include "ContainerStats.h"
+#include <atomic>
+
+/* Process wide counters. Relaxed, since they are only ever read as a snapshot. */
+static std::atomic<uint64_t> globalAllocations = 0;
+static std::atomic<uint64_t> globalReallocations = 0;
+static std::atomic<uint64_t> globalBytesCopied = 0;
+static std::atomic<uint64_t> globalHeapPromotions = 0;
+static std::atomic<uint64_t> globalRehashes = 0;
+static std::atomic<uint64_t> globalMaxBucketLength = 0;
+
+ContainerStats GetGlobalContainerStats()
+{
+	ContainerStats stats;
+	stats.allocations = globalAllocations.load(std::memory_order_relaxed);
+	stats.reallocations = globalReallocations.load(std::memory_order_relaxed);
+	stats.bytesCopied = globalBytesCopied.load(std::memory_order_relaxed);
+	stats.heapPromotions = globalHeapPromotions.load(std::memory_order_relaxed);
+	stats.rehashes = globalRehashes.load(std::memory_order_relaxed);
+	stats.maxBucketLength = globalMaxBucketLength.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void ResetGlobalContainerStats()
+{
+	globalAllocations.store(0, std::memory_order_relaxed);
+	globalReallocations.store(0, std::memory_order_relaxed);
+	globalBytesCopied.store(0, std::memory_order_relaxed);
+	globalHeapPromotions.store(0, std::memory_order_relaxed);
+	globalRehashes.store(0, std::memory_order_relaxed);
+	globalMaxBucketLength.store(0, std::memory_order_relaxed);
+}
+
+void ContainerStatsInternal::AddAllocation()
+{
+	globalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ContainerStatsInternal::AddReallocation()
+{
+	globalReallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ContainerStatsInternal::AddBytesCopied(uint64_t bytes)
+{
+	globalBytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void ContainerStatsInternal::AddHeapPromotion()
+{
+	globalHeapPromotions.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ContainerStatsInternal::AddRehash()
+{
+	globalRehashes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ContainerStatsInternal::UpdateMaxBucketLength(uint64_t length)
+{
+	uint64_t current = globalMaxBucketLength.load(std::memory_order_relaxed);
+	while (length > current && !globalMaxBucketLength.compare_exchange_weak(current, length, std::memory_order_relaxed)) {}
+}
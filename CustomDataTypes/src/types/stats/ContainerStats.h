@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <types/allocator/Allocator.h>
+
+/* Count allocations, reallocations, copied bytes, small string promotions, and map rehashes within darray, String, SString and Map.
+Disabled by default, in which case the counters occupy no space and every hook compiles to nothing.
+Must be set the same way for every translation unit, by doing
+-- #define CONTAINER_STATS true -- before including any container header, or through the project's preprocessor definitions. */
+#ifndef CONTAINER_STATS
+#define CONTAINER_STATS false
+#endif
+
+/* Snapshot of container activity, either of a single container or of every container in the process. */
+struct ContainerStats
+{
+	/* Heap blocks allocated, including the first allocation of a container. */
+	uint64_t allocations = 0;
+
+	/* Capacity changes of an existing data block, whether or not the block moved. */
+	uint64_t reallocations = 0;
+
+	/* Bytes of elements or characters copied or moved between blocks, or into a container. */
+	uint64_t bytesCopied = 0;
+
+	/* Small strings that outgrew their inline storage and moved to the heap. */
+	uint64_t heapPromotions = 0;
+
+	/* Times a map grew it's bucket array and redistributed every pair. */
+	uint64_t rehashes = 0;
+
+	/* Most pairs ever stored in a single map bucket. */
+	uint64_t maxBucketLength = 0;
+};
+
+/* Sum of the stats of every container since the start of the process, or the last reset. maxBucketLength is the max of every map.
+All zeros when CONTAINER_STATS is disabled. */
+ContainerStats GetGlobalContainerStats();
+
+/* Zero the process wide stats. Does not affect the stats of individual containers. */
+void ResetGlobalContainerStats();
+
+namespace ContainerStatsInternal {
+	void AddAllocation();
+	void AddReallocation();
+	void AddBytesCopied(uint64_t bytes);
+	void AddHeapPromotion();
+	void AddRehash();
+	void UpdateMaxBucketLength(uint64_t length);
+}
+
+#if CONTAINER_STATS == true
+
+/* Stats of a single container, also added to the process wide stats. Copies of a container start with their own zeroed stats.
+Activity during constant evaluation is only counted for the container itself. */
+struct container_stats_tracker
+{
+	ContainerStats stats;
+
+	constexpr container_stats_tracker() {}
+	constexpr container_stats_tracker(const container_stats_tracker&) {}
+	constexpr container_stats_tracker& operator = (const container_stats_tracker&) { return *this; }
+
+	constexpr void Allocation()
+	{
+		stats.allocations++;
+		if (!std::is_constant_evaluated()) {
+			ContainerStatsInternal::AddAllocation();
+		}
+	}
+
+	constexpr void Reallocation()
+	{
+		stats.reallocations++;
+		if (!std::is_constant_evaluated()) {
+			ContainerStatsInternal::AddReallocation();
+		}
+	}
+
+	constexpr void BytesCopied(uint64_t bytes)
+	{
+		stats.bytesCopied += bytes;
+		if (!std::is_constant_evaluated()) {
+			ContainerStatsInternal::AddBytesCopied(bytes);
+		}
+	}
+
+	constexpr void HeapPromotion()
+	{
+		stats.heapPromotions++;
+		if (!std::is_constant_evaluated()) {
+			ContainerStatsInternal::AddHeapPromotion();
+		}
+	}
+
+	constexpr void Rehash()
+	{
+		stats.rehashes++;
+		if (!std::is_constant_evaluated()) {
+			ContainerStatsInternal::AddRehash();
+		}
+	}
+
+	constexpr void BucketLength(uint64_t length)
+	{
+		if (length > stats.maxBucketLength) {
+			stats.maxBucketLength = length;
+			if (!std::is_constant_evaluated()) {
+				ContainerStatsInternal::UpdateMaxBucketLength(length);
+			}
+		}
+	}
+
+	constexpr ContainerStats Get() const { return stats; }
+};
+
+#else
+
+/* Disabled stats. Empty, and every hook does nothing. */
+struct container_stats_tracker
+{
+	constexpr void Allocation() {}
+	constexpr void Reallocation() {}
+	constexpr void BytesCopied(uint64_t) {}
+	constexpr void HeapPromotion() {}
+	constexpr void Rehash() {}
+	constexpr void BucketLength(uint64_t) {}
+
+	constexpr ContainerStats Get() const { return ContainerStats(); }
+};
+
+#endif
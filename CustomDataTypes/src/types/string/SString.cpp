@@ -14,11 +14,13 @@ SString SString::Concatenate(const SString& left, const SString& right)
 		memcpy(&str.sso_chars[left.GetSmallStringLength()], Str2Data, right.GetSmallStringLength() + 1);
 	}
 	else {
-		char* NewData = new char[slen + 1];
+		char* NewData = str.AllocateLongData(slen + 1);
 		memcpy(NewData, Str1Data, left.Length());
 		memcpy(&NewData[left.Length()], Str2Data, right.Length() + 1);
 		str.data = NewData;
+		str.stats.Allocation();
 	}
+	str.stats.BytesCopied(slen + 1);
 
 	return str;
 }
@@ -32,15 +34,24 @@ void SString::Append(const char* str)
 		SetSmallLength(slen + currentlen);
 	}
 	else {
-		char* newData = new char[slen + currentlen + 1];
+		bool arena;
+		char* newData = StringArena::AllocateChars(slen + currentlen + 1, arena);
 		memcpy(newData, CStr(), currentlen);
 		memcpy(&newData[currentlen], str, slen + 1);
+		stats.Allocation();
+		stats.BytesCopied(currentlen);
 		if (!IsSmallString()) {
-			delete[] data;
+			stats.Reallocation();
+			FreeLongData();
+		}
+		else {
+			stats.HeapPromotion();
 		}
 		data = newData;
 		SetLongLength(slen + currentlen);
+		SetArenaData(arena);
 	}
+	stats.BytesCopied(slen + 1);
 }
 
 void SString::Append(const SString& other)
@@ -52,13 +63,22 @@ void SString::Append(const SString& other)
 		SetSmallLength(slen + currentlen);
 	}
 	else {
-		char* newData = new char[slen + currentlen + 1];
+		bool arena;
+		char* newData = StringArena::AllocateChars(slen + currentlen + 1, arena);
 		memcpy(newData, CStr(), currentlen);
 		memcpy(&newData[currentlen], other.CStr(), slen + 1);
+		stats.Allocation();
+		stats.BytesCopied(currentlen);
 		if (!IsSmallString()) {
-			delete[] data;
+			stats.Reallocation();
+			FreeLongData();
+		}
+		else {
+			stats.HeapPromotion();
 		}
 		data = newData;
 		SetLongLength(slen + currentlen);
+		SetArenaData(arena);
 	}
+	stats.BytesCopied(slen + 1);
 }
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <iostream>
+#include <types/array/DynamicArray.h>
+#include <types/stats/ContainerStats.h>
+#include <types/string/StringArena.h>
+#include <types/string/StringView.h>
 
 #define MAX_SMALL_SSTRING_LENGTH			sizeof(char*) + sizeof(size_t) - 1
 #define SSTRING_SMALL_FLAG_BIT				0b10000000
 #define SSTRING_SMALL_OTHER_BITS			0b01111111
-#define SSTRING_LONG_LENGTH_BITMASK		0b0111111111111111111111111111111111111111111111111111111111111111UL
+#define SSTRING_LONG_LENGTH_BITMASK		0b0011111111111111111111111111111111111111111111111111111111111111UL
+/* Set in the long length when the chars belong to an arena. See StringArenaScope. */
+#define SSTRING_LONG_ARENA_BIT				0b0100000000000000000000000000000000000000000000000000000000000000UL
 
 struct SString 
 {
@@ -25,6 +31,9 @@ private:
 		};
 	};
 
+	/* Allocation and promotion counters. Occupies no space unless CONTAINER_STATS is enabled. */
+	DARRAY_NO_UNIQUE_ADDRESS container_stats_tracker stats;
+
 	void SetIsSmallString() {
 		sso_chars[MAX_SMALL_SSTRING_LENGTH] &= ~(1 << 7);
 	}
@@ -51,6 +60,30 @@ private:
 		return length & SSTRING_LONG_LENGTH_BITMASK;
 	}
 
+	/* Whether this long string's chars belong to an arena, and are never freed by the string. */
+	__forceinline bool IsArenaData() const {
+		return length & SSTRING_LONG_ARENA_BIT;
+	}
+
+	/* Mark whether this long string's chars belong to an arena. Must be called after setting the long length. */
+	__forceinline void SetArenaData(bool arena) {
+		length = arena ? (length | SSTRING_LONG_ARENA_BIT) : (length & ~SSTRING_LONG_ARENA_BIT);
+	}
+
+	/* Allocate chars for this long string, from the arena of the thread's StringArenaScope if there is one, otherwise the heap.
+	Doesn't free the current chars. Must already be a long string. */
+	char* AllocateLongData(size_t count) {
+		bool arena;
+		char* block = StringArena::AllocateChars(count, arena);
+		SetArenaData(arena);
+		return block;
+	}
+
+	/* Free this long string's chars, unless they belong to an arena. */
+	void FreeLongData() {
+		StringArena::FreeChars(data, IsArenaData());
+	}
+
 	void SetLength(size_t new_length) {
 		if (new_length > MAX_SMALL_SSTRING_LENGTH) {
 			SetLongLength(new_length);
@@ -74,9 +107,23 @@ public:
 			memcpy(sso_chars, str, slen + 1);
 		}
 		else {
-			data = new char[slen + 1];
+			data = AllocateLongData(slen + 1);
 			memcpy(data, str, slen + 1);
+			stats.Allocation();
 		}
+		stats.BytesCopied(slen + 1);
+	}
+
+	/* Construct from the first slen chars of a buffer, which doesn't need to be null terminated. */
+	SString(const char* str, size_t slen) {
+		SetLength(slen);
+		char* chars = IsSmallString() ? sso_chars : (data = AllocateLongData(slen + 1));
+		memcpy(chars, str, slen);
+		chars[slen] = '\0';
+		if (!IsSmallString()) {
+			stats.Allocation();
+		}
+		stats.BytesCopied(slen + 1);
 	}
 
 	SString(const SString& other) {
@@ -86,14 +133,23 @@ public:
 			memcpy(sso_chars, other.CStr(), slen + 1);
 		}
 		else {
-			data = new char[slen + 1];
+			data = AllocateLongData(slen + 1);
 			memcpy(data, other.CStr(), slen + 1);
+			stats.Allocation();
 		}
+		stats.BytesCopied(slen + 1);
+	}
+
+	/* Move constructor. Takes the other string's heap data without allocating or copying it. The other string is left as "". */
+	SString(SString&& other) noexcept {
+		memcpy(sso_chars, other.sso_chars, sizeof(sso_chars));
+		other.sso_chars[0] = '\0';
+		other.SetSmallLength(0);
 	}
 
 	~SString() {
 		if (!IsSmallString()) {
-			delete[] data;
+			FreeLongData();
 		}
 	}
 
@@ -115,6 +171,21 @@ public:
 		}
 	}
 
+	/* Get a view of the whole string. Invalidated by any change to the string. */
+	StringView View() const {
+		return StringView(CStr(), Length());
+	}
+
+	/* See View(). */
+	operator StringView() const {
+		return View();
+	}
+
+	/* Hash of the string's chars. Equal to the hash of a StringView or String with the same chars. */
+	uint64 Hash() const {
+		return View().Hash();
+	}
+
 	/* std::cout << SString */
 	friend std::ostream& operator << (std::ostream& os, SString& str)
 	{
@@ -123,7 +194,7 @@ public:
 	}
 
 	void operator = (const char* str) {
-		if (!IsSmallString() && data) delete[] data;
+		if (!IsSmallString()) FreeLongData();
 
 		const size_t slen = strlen(str);
 		SetLength(slen);
@@ -131,13 +202,15 @@ public:
 			memcpy(sso_chars, str, slen + 1);
 		}
 		else {
-			data = new char[slen + 1];
+			data = AllocateLongData(slen + 1);
 			memcpy(data, str, slen + 1);
+			stats.Allocation();
 		}
+		stats.BytesCopied(slen + 1);
 	}
 
 	void operator = (const SString& other) {
-		if (!IsSmallString() && data) delete[] data;
+		if (!IsSmallString()) FreeLongData();
 
 		const size_t slen = other.Length();
 		SetLength(slen);
@@ -145,9 +218,24 @@ public:
 			memcpy(sso_chars, other.CStr(), slen + 1);
 		}
 		else {
-			data = new char[slen + 1];
+			data = AllocateLongData(slen + 1);
 			memcpy(data, other.CStr(), slen + 1);
+			stats.Allocation();
 		}
+		stats.BytesCopied(slen + 1);
+	}
+
+	/* Set equal to another string, taking it's heap data without allocating or copying it. The other string is left as "". */
+	void operator = (SString&& other) noexcept {
+		if (this == &other) {
+			return;
+		}
+		if (!IsSmallString()) {
+			FreeLongData();
+		}
+		memcpy(sso_chars, other.sso_chars, sizeof(sso_chars));
+		other.sso_chars[0] = '\0';
+		other.SetSmallLength(0);
 	}
 
 	bool operator == (const char* str) {
@@ -176,4 +264,14 @@ public:
 	void operator += (const SString& other) {
 		Append(other);
 	}
-};
\ No newline at end of file
+
+	/* Get the heap allocations, reallocations, copied bytes and small string promotions of this string.
+	All zeros unless CONTAINER_STATS is enabled. Copies of a string start with their own zeroed stats. */
+	ContainerStats GetStats() const {
+		return stats.Get();
+	}
+};
+
+/* Strings never point into themselves, so arrays of them grow with a memcpy instead of moving each string. */
+template<>
+struct darray_trivially_relocatable<SString> : std::true_type {};
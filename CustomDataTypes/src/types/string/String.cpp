@@ -1,4 +1,15 @@
 #include "String.h"
+#include "SString.h"
+#include "StringArena.h"
+#include "StringBuilder.h"
+#include "StringPool.h"
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <types/map/Map.h>
+#include <types/test/UnitTest.h>
 
 String String::ConcatenateStrings(const String& Str1, const String& Str2)
 {
@@ -15,12 +26,14 @@ String String::ConcatenateStrings(const String& Str1, const String& Str2)
 		memcpy(&_String.chars[Str1.SmallStringLength()], Str2Data, Str2.SmallStringLength() + 1);
 	}
 	else {
-		char* NewData = new char[NewCapacity];
+		char* NewData = _String.AllocateLongData(NewCapacity);
 		memcpy(NewData, Str1Data, Str1.Length());
 		memcpy(&NewData[Str1.Length()], Str2Data, Str2.Length() + 1);
 		_String.data = NewData;
 		_String.capacity = NewCapacity;
+		_String.stats.Allocation();
 	}
+	_String.stats.BytesCopied(NewSize + 1);
 	return _String;
 }
 
@@ -42,92 +55,520 @@ void String::AppendString(const String& Other)
 		memcpy(&data[InitialLength], otherStr, Other.Length() + 1);
 		SetLengthLong(NewSize);
 	}
+	stats.BytesCopied(Other.Length() + 1);
 }
 
-String String::Substring(uint64 start, uint64 end)
+String String::Substring(uint64 start, uint64 end) const
 {
 	const uint64 len = Length();
-	if (start > len || end > len) {
+	if (start > end || end > len) {
 		std::cout << "String::Substring() start or end exceeds the strings current length.\n";
 		return String();
 	}
 
-	const uint64 newlen = end - start;
-	const char* cstr = CString();
-	char* substr = new char[newlen + 1];
-	memcpy(substr, &CString()[start], newlen);
-	substr[newlen] = '\0';
-	return String(substr);
+	return String(&CString()[start], end - start);
 }
 
-darray<String> String::Split(char splitter)
+darray<String> String::Split(char splitter) const
 {
-	std::cout << "gonna split string " << *this << std::endl;
-
-	uint64 first = 0;
-
-	const char* cstr = CString();
-	const uint64 len = Length();
-
 	darray<String> arr;
-
-	for (int i = 0; i < len + 1; i++) {
-		if (cstr[i] == splitter) {
-			std::cout << "split found" << '\n';
-			arr.Add(Substring(first, i));
-			first = i + 1;
-			i++;
-		}
-
-		if (i == len) {
-			arr.Add(Substring(first, i));
-		}
-	}
-
+	View().ForEachSplit(splitter, [&arr](StringView piece) {
+		arr.Emplace(piece);
+	});
 	return arr;
 }
 
-darray<String> String::Split(const String& splitter)
+darray<String> String::Split(StringView splitter) const
 {
-	uint64 first = 0;
+	darray<String> arr;
+	View().ForEachSplit(splitter, [&arr](StringView piece) {
+		arr.Emplace(piece);
+	});
+	return arr;
+}
 
-	const uint64 splitlen = splitter.Length();
-	const uint64 len = Length();
-	const char* cstr = CString();
+uint64 String::Find(StringView substring, uint64 start) const
+{
+	return View().Find(substring, start);
+}
 
-	darray<String> arr;
+uint64 String::Find(char c, uint64 start) const
+{
+	return View().Find(c, start);
+}
 
-	for (int i = 0; i < len + 1; i++) {
-		const uint64 end = i + splitlen;
-		if (end < len) {
-			if (Substring(i, end) == splitter) {
-				arr.Add(Substring(first, i));
-				first = end;
-				i += splitlen;
-			}
-		}
+uint64 String::FindLast(StringView substring) const
+{
+	return View().FindLast(substring);
+}
 
-		if (i == len) {
-			arr.Add(Substring(first, i));
-		}
-	}
+uint64 String::FindLast(char c) const
+{
+	return View().FindLast(c);
+}
 
-	return arr;
+uint64 String::Count(StringView substring) const
+{
+	return View().Count(substring);
 }
 
+uint64 String::Count(char c) const
+{
+	return View().Count(c);
+}
 
+char* String::InitializeUninitialized(uint64 NewLength)
+{
+	SetLength(NewLength);
+	char* out = chars;
+	if (!IsSmallString()) {
+		capacity = NewLength + 1;
+		data = AllocateLongData(capacity);
+		out = data;
+		stats.Allocation();
+	}
+	out[NewLength] = '\0';
+	stats.BytesCopied(NewLength + 1);
+	return out;
+}
 
 void String::IncreaseLongStringCapacity(uint64 MinCapacity)
 {
 	const uint64 NewCapacity = 3 * (MinCapacity) >> 1;
-	char* NewData = new char[NewCapacity];
+	bool NewArena;
+	char* NewData = StringArena::AllocateChars(NewCapacity, NewArena);
 	const char* OldData = CString();
 	memcpy(NewData, OldData, Length() + 1);
+	stats.Allocation();
+	stats.BytesCopied(Length() + 1);
 	if (!IsSmallString()) {
-		delete[] data;
+		stats.Reallocation();
+		FreeLongData();
+	}
+	else {
+		stats.HeapPromotion();
 	}
-	data = NewData;
-	capacity = NewCapacity;
 	SetLengthLong(Length());
 	SetIsLongString();
+	data = NewData;
+	capacity = NewCapacity;
+	SetArenaData(NewArena);
+}
+
+#if RUNTIME_UNIT_TESTS == true
+namespace StringRuntimeUnitTests
+{
+	/* Pseudo random text over the first alphabetSize letters. Small alphabets give many partial matches. */
+	static std::string RandomText(unsigned int& state, size_t length, int alphabetSize)
+	{
+		std::string text;
+		for (size_t i = 0; i < length; i++) {
+			state = state * 1103515245 + 12345;
+			text += char('a' + (state >> 16) % alphabetSize);
+		}
+		return text;
+	}
+
+	/* Find and FindLast agree with std::string::find and std::string::rfind, with not found mapped to the haystack length. */
+	static bool MatchesStd(const std::string& haystack, const std::string& needle, size_t start)
+	{
+		const size_t length = haystack.size();
+		const size_t expectedFirst = haystack.find(needle, start);
+		const size_t expectedLast = haystack.rfind(needle);
+		const size_t first = StringSearch::Find(haystack.data(), length, needle.data(), needle.size(), start);
+		const size_t last = StringSearch::FindLast(haystack.data(), length, needle.data(), needle.size());
+		return first == (expectedFirst == std::string::npos ? length : expectedFirst)
+			&& last == (expectedLast == std::string::npos ? length : expectedLast);
+	}
+
+	/* Randomized haystacks and needles, including needles cut from the haystack, against the std searches. */
+	static void StringSearchRandomTests()
+	{
+		unsigned int state = 987654321;
+		for (int round = 0; round < 2000; round++) {
+			const int alphabetSize = 2 + round % 3;
+			const std::string haystack = RandomText(state, size_t(round % 300), alphabetSize);
+			const size_t needleLength = size_t(round % 11);
+			std::string needle = RandomText(state, needleLength, alphabetSize);
+			if (round % 2 == 0 && haystack.size() >= needleLength) {
+				needle = haystack.substr((haystack.size() - needleLength) * (round % 7) / 7, needleLength);
+			}
+			const size_t start = haystack.empty() ? 0 : size_t(round) % haystack.size();
+			RUNTIME_TEST_ASSERT(MatchesStd(haystack, needle, 0));
+			RUNTIME_TEST_ASSERT(MatchesStd(haystack, needle, start));
+
+			const String str = haystack.c_str();
+			const uint64 expected = haystack.find(needle, start);
+			RUNTIME_TEST_ASSERT(str.Find(needle.c_str(), start) == (expected == std::string::npos ? STRING_NOT_FOUND : expected));
+		}
+	}
+	RUNTIME_TEST_SUITE(StringSearchRandomTests);
+
+	/* Haystacks where nearly every position matches the needle's first and last bytes, so verifying candidates
+	exceeds the budget and the searches finish with Knuth-Morris-Pratt. */
+	static void StringSearchRepetitiveTests()
+	{
+		const std::string needle = std::string(19, 'a') + "b" + std::string(20, 'a');
+		for (size_t length : { size_t(100), size_t(1000), size_t(5000) }) {
+			const std::string run(length, 'a');
+			RUNTIME_TEST_ASSERT(MatchesStd(run, needle, 0));
+			RUNTIME_TEST_ASSERT(MatchesStd(run + needle, needle, 0));
+			RUNTIME_TEST_ASSERT(MatchesStd(needle + run, needle, 0));
+			RUNTIME_TEST_ASSERT(MatchesStd(run + needle + run + needle + run, needle, 7));
+
+			const std::string haystack = run + needle + run;
+			RUNTIME_TEST_ASSERT(StringSearch::Find(haystack.data(), haystack.size(), needle.data(), needle.size()) == length);
+			RUNTIME_TEST_ASSERT(StringSearch::FindLast(haystack.data(), haystack.size(), needle.data(), needle.size()) == length);
+			RUNTIME_TEST_ASSERT(StringSearch::Count(haystack.data(), haystack.size(), "aa", 2) == (haystack.size() - 1) / 2);
+		}
+
+		// The fallback on it's own, from both directions.
+		unsigned int state = 42;
+		for (int round = 0; round < 500; round++) {
+			const std::string haystack = RandomText(state, size_t(round), 2);
+			const std::string search = RandomText(state, 1 + size_t(round % 6), 2);
+			const size_t expectedFirst = haystack.find(search);
+			const size_t expectedLast = haystack.rfind(search);
+			const size_t first = StringSearch::Internal::KmpSearch(haystack.data(), haystack.size(), search.data(), search.size(), 0, false, 0);
+			RUNTIME_TEST_ASSERT(first == (expectedFirst == std::string::npos ? haystack.size() : expectedFirst));
+			if (haystack.size() >= search.size()) {
+				const size_t last = StringSearch::Internal::KmpSearch(haystack.data(), haystack.size(), search.data(), search.size(), 0, true, haystack.size() - search.size());
+				RUNTIME_TEST_ASSERT(last == (expectedLast == std::string::npos ? haystack.size() : expectedLast));
+			}
+		}
+	}
+	RUNTIME_TEST_SUITE(StringSearchRepetitiveTests);
+
+	/* Whether split pieces are exactly the expected strings. */
+	static bool SplitEquals(const darray<String>& pieces, std::initializer_list<const char*> expected)
+	{
+		if (pieces.Size() != ArrInt(expected.size())) {
+			return false;
+		}
+		ArrInt i = 0;
+		for (const char* piece : expected) {
+			if (pieces.GetData()[i++] != piece) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Consecutive splitters give empty pieces between them, and leading or trailing splitters give empty pieces at the ends. */
+	static void StringSplitTests()
+	{
+		RUNTIME_TEST_ASSERT(SplitEquals(String("a,,b,").Split(','), { "a", "", "b", "" }));
+		RUNTIME_TEST_ASSERT(SplitEquals(String(",,").Split(','), { "", "", "" }));
+		RUNTIME_TEST_ASSERT(SplitEquals(String("").Split(','), { "" }));
+		RUNTIME_TEST_ASSERT(SplitEquals(String("abc").Split(','), { "abc" }));
+		RUNTIME_TEST_ASSERT(SplitEquals(String("a--b----").Split("--"), { "a", "b", "", "" }));
+		RUNTIME_TEST_ASSERT(SplitEquals(String("--a").Split("--"), { "", "a" }));
+		RUNTIME_TEST_ASSERT(SplitEquals(String("aaa").Split("aa"), { "", "a" }));
+		RUNTIME_TEST_ASSERT(String("x::y::").SplitView("::").Size() == 3);
+	}
+	RUNTIME_TEST_SUITE(StringSplitTests);
+
+	/* Whether split views are exactly the expected strings. */
+	static bool SplitViewEquals(const darray<StringView>& pieces, std::initializer_list<const char*> expected)
+	{
+		if (pieces.Size() != ArrInt(expected.size())) {
+			return false;
+		}
+		ArrInt i = 0;
+		for (const char* piece : expected) {
+			if (pieces.GetData()[i++] != StringView(piece)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Substring views clamp their end to the string, and are empty when the start is at or past the end. */
+	static void StringSubstringViewTests()
+	{
+		for (const char* chars : { "hello world", "hello world, well past the small string limit" }) {
+			const String str = chars;
+			const uint64 length = str.Length();
+			RUNTIME_TEST_ASSERT(str.SubstringView(0, 5) == StringView("hello") && str.SubstringView(0, 5).Data() == str.CString());
+			RUNTIME_TEST_ASSERT(str.SubstringView(6, 11) == StringView("world") && str.SubstringView(6, 11).Data() == str.CString() + 6);
+			RUNTIME_TEST_ASSERT(str.SubstringView(0, length) == StringView(chars) && str.SubstringView(0, STRING_NOT_FOUND) == StringView(chars));
+			RUNTIME_TEST_ASSERT(str.SubstringView(length - 1, length + 100).Length() == 1);
+			for (uint64 start : { uint64(3), length, length + 1, STRING_NOT_FOUND }) {
+				const StringView empty = str.SubstringView(start, start <= length ? start : 3);
+				RUNTIME_TEST_ASSERT(empty.Length() == 0 && empty.Data() != nullptr);
+			}
+			RUNTIME_TEST_ASSERT(str.SubstringView(7, 3).Length() == 0 && str.SubstringView(length, STRING_NOT_FOUND).Length() == 0);
+			RUNTIME_TEST_ASSERT(String(str.SubstringView(2, 4)) == str.Substring(2, 4));
+		}
+		RUNTIME_TEST_ASSERT(String().SubstringView(0, 10).Length() == 0);
+	}
+	RUNTIME_TEST_SUITE(StringSubstringViewTests);
+
+	/* Split views have the same pieces as Split(), pointing into the string, including at the ends and for empty or oversized splitters. */
+	static void StringSplitViewTests()
+	{
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("").SplitView(','), { "" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String(",").SplitView(','), { "", "" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String(",a,").SplitView(','), { "", "a", "" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("abc").SplitView(','), { "abc" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("abc").SplitView(""), { "abc" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("ab").SplitView("abc"), { "ab" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("abc").SplitView("abc"), { "", "" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("aaaa").SplitView("aa"), { "", "", "" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("aaa").SplitView("aa"), { "", "a" }));
+		RUNTIME_TEST_ASSERT(SplitViewEquals(String("").SplitView("::"), { "" }));
+
+		// Splitters at the edges of the search kernels' vectors, in a long string.
+		std::string text(100, 'x');
+		for (size_t i : { 0, 15, 16, 31, 32, 63, 64, 99 }) {
+			text[i] = ';';
+		}
+		const String str = text.c_str();
+		const darray<StringView> views = str.SplitView(';');
+		const darray<String> copies = str.Split(';');
+		RUNTIME_TEST_ASSERT(views.Size() == 9 && copies.Size() == 9);
+		uint64 offset = 0;
+		for (ArrInt i = 0; i < views.Size(); i++) {
+			const StringView view = views.GetData()[i];
+			RUNTIME_TEST_ASSERT(view.Data() == str.CString() + offset && String(view) == copies.GetData()[i]);
+			offset += view.Length() + 1;
+		}
+		RUNTIME_TEST_ASSERT(offset == str.Length() + 1);
+	}
+	RUNTIME_TEST_SUITE(StringSplitViewTests);
+
+	/* Concat joins every kind of piece in order. Integers are formatted rather than narrowed to a char, and their digits live long enough to be copied.
+	StringBuilder formats the same pieces, and can be reused after Clear(). */
+	static void StringConcatTests()
+	{
+		const String str = "string";
+		const String longStr = "a long string, well past the small string limit";
+		const SString sStr = "sstring";
+		const char c = 'c';
+		const int negative = -42;
+		RUNTIME_TEST_ASSERT(String::Concat() == "");
+		RUNTIME_TEST_ASSERT(String::Concat("n=", 65) == "n=65");
+		RUNTIME_TEST_ASSERT(String::Concat(1000, ',', 'x') == "1000,x");
+		RUNTIME_TEST_ASSERT(String::Concat(str, ' ', sStr, " c-string ", c, negative, ' ', true, '/', false) == "string sstring c-string c-42 true/false");
+		RUNTIME_TEST_ASSERT(String::Concat(longStr, ": ", std::numeric_limits<long long>::min(), ' ', std::numeric_limits<unsigned long long>::max())
+			== String::Concat(longStr.View(), ": -9223372036854775808 18446744073709551615"));
+		RUNTIME_TEST_ASSERT(String::Concat((unsigned char)200, (signed char)-5, (short)7, 0u, StringView("view")) == "200-570view");
+
+		// A cleared builder keeps nothing of it's earlier pieces.
+		StringBuilder builder;
+		builder.Append(str).Append(' ').Append(1000).AppendCopy(longStr.View());
+		builder.Clear();
+		RUNTIME_TEST_ASSERT(builder.Length() == 0 && builder.PieceCount() == 0 && builder.Build() == "");
+		builder.Append(sStr.View()).Append(c).Append(negative);
+		RUNTIME_TEST_ASSERT(builder.Build() == String::Concat(sStr, c, negative));
+	}
+	RUNTIME_TEST_SUITE(StringConcatTests);
+
+	/* Many threads hashing the same const long string all get the hash of it's chars, and later copies reuse the published hash. */
+	static void StringConcurrentHashTests()
+	{
+		const String str = "a long string, well past the small string limit, hashed from many threads";
+		const uint64 expected = StringView(str).Hash();
+		std::atomic<int> mismatches = 0;
+		darray<std::thread> threads;
+		for (int i = 0; i < 4; i++) {
+			threads.Add(std::thread([&]() {
+				for (int j = 0; j < 1000; j++) {
+					if (str.Hash() != expected) {
+						mismatches++;
+					}
+				}
+			}));
+		}
+		for (ArrInt i = 0; i < threads.Size(); i++) {
+			threads[i].join();
+		}
+		RUNTIME_TEST_ASSERT(mismatches == 0);
+		const String copy = str;
+		RUNTIME_TEST_ASSERT(copy.Hash() == expected && copy == str);
+	}
+	RUNTIME_TEST_SUITE(StringConcurrentHashTests);
+
+	/* String keys hashed with HashString land in the bucket of their hash, including after the map grows and rehashes it's stored keys. */
+	static void StringMapKeyTests()
+	{
+		Map<String, int, HashString> map;
+		for (int i = 0; i < 200; i++) {
+			const String key = String::Concat("a key long enough to be stored on the heap, number ", std::to_string(i).c_str());
+			map.Add(key, i);
+		}
+		RUNTIME_TEST_ASSERT(map.elementCount == 200 && map.bucketCount > MAP_INITIAL_CAPACITY);
+		int found = 0;
+		for (ArrInt b = 0; b < map.buckets.Size(); b++) {
+			for (ArrInt p = 0; p < map.buckets[b].elements.Size(); p++) {
+				const String& key = map.buckets[b].elements[p].key;
+				RUNTIME_TEST_ASSERT(ArrInt(key.Hash()) % map.bucketCount == b && key.Hash() == StringView(key).Hash());
+				found++;
+			}
+		}
+		RUNTIME_TEST_ASSERT(found == 200);
+	}
+	RUNTIME_TEST_SUITE(StringMapKeyTests);
+
+	/* Moving leaves the source an empty small string that's still usable, and moving a string into itself keeps it's chars.
+	Long strings hand over their heap chars without copying them. */
+	static void StringMoveTests()
+	{
+		const char* longChars = "a long string, well past the small string limit, moved around";
+		for (const char* chars : { "short", longChars }) {
+			String source = chars;
+			const bool small = source.IsSmallString();
+			const char* data = source.CString();
+			String moved = std::move(source);
+			RUNTIME_TEST_ASSERT(moved == chars && (small || moved.CString() == data));
+			RUNTIME_TEST_ASSERT(source.IsSmallString() && source.Length() == 0 && source == "");
+			source += "reused";
+			RUNTIME_TEST_ASSERT(source == "reused");
+
+			// Assigning over both a small and a long string.
+			String assigned = longChars;
+			assigned = std::move(moved);
+			RUNTIME_TEST_ASSERT(assigned == chars && moved.IsSmallString() && moved.Length() == 0);
+			String& alias = assigned;
+			assigned = std::move(alias);
+			RUNTIME_TEST_ASSERT(assigned == chars && assigned.IsSmallString() == small);
+
+			SString sSource = chars;
+			const char* sData = sSource.CStr();
+			SString sMoved = std::move(sSource);
+			RUNTIME_TEST_ASSERT(sMoved.View() == StringView(chars) && (small || sMoved.CStr() == sData));
+			RUNTIME_TEST_ASSERT(sSource.IsSmallString() && sSource.Length() == 0 && sSource.CStr()[0] == '\0');
+			sSource.Append("reused");
+			RUNTIME_TEST_ASSERT(sSource.View() == StringView("reused"));
+
+			SString sAssigned = longChars;
+			sAssigned = std::move(sMoved);
+			RUNTIME_TEST_ASSERT(sAssigned.View() == StringView(chars) && sMoved.IsSmallString() && sMoved.Length() == 0);
+			SString& sAlias = sAssigned;
+			sAssigned = std::move(sAlias);
+			RUNTIME_TEST_ASSERT(sAssigned.View() == StringView(chars) && sAssigned.IsSmallString() == small);
+		}
+	}
+	RUNTIME_TEST_SUITE(StringMoveTests);
+
+	constexpr int INTERN_THREADS = 4;
+
+	constexpr int INTERNED_STRINGS = 3000;
+
+	/* Threads interning the same strings at once, in different orders and across table growths, all get the same atom for each string,
+	and different strings get different atoms. Lookups running at the same time only ever find the right atom. */
+	static void StringPoolConcurrentInternTests()
+	{
+		darray<std::string> strings;
+		for (int i = 0; i < INTERNED_STRINGS; i++) {
+			strings.Add(i % 2 == 0 ? std::to_string(i) : "an interned string long enough to be on the heap, number " + std::to_string(i));
+		}
+
+		StringPool pool;
+		std::unique_ptr<Atom[]> atoms(new Atom[INTERN_THREADS * INTERNED_STRINGS]);
+		std::atomic<bool> interning = true;
+		std::atomic<int> wrongLookups = 0;
+		darray<std::thread> threads;
+		for (int t = 0; t < INTERN_THREADS; t++) {
+			threads.Add(std::thread([&, t]() {
+				for (int n = 0; n < INTERNED_STRINGS; n++) {
+					// Each thread starts at a different string, and odd threads go backwards.
+					const int offset = (n + t * INTERNED_STRINGS / INTERN_THREADS) % INTERNED_STRINGS;
+					const int i = t % 2 == 0 ? offset : INTERNED_STRINGS - 1 - offset;
+					const std::string& str = strings.GetData()[i];
+					const Atom atom = pool.Intern(StringView(str.c_str(), str.size()));
+					atoms[t * INTERNED_STRINGS + i] = atom;
+					if (pool.Get(atom) != StringView(str.c_str(), str.size())) {
+						wrongLookups++;
+					}
+				}
+			}));
+		}
+		threads.Add(std::thread([&]() {
+			while (interning.load()) {
+				for (int i = 0; i < INTERNED_STRINGS; i += 7) {
+					const std::string& str = strings.GetData()[i];
+					Atom atom;
+					if (pool.Find(StringView(str.c_str(), str.size()), atom) && pool.Get(atom) != StringView(str.c_str(), str.size())) {
+						wrongLookups++;
+					}
+				}
+			}
+		}));
+		for (ArrInt t = 0; t < INTERN_THREADS; t++) {
+			threads[t].join();
+		}
+		interning = false;
+		threads[INTERN_THREADS].join();
+
+		RUNTIME_TEST_ASSERT(wrongLookups == 0);
+		RUNTIME_TEST_ASSERT(pool.Count() == INTERNED_STRINGS + 1);
+		std::unique_ptr<bool[]> usedIds(new bool[INTERNED_STRINGS + 1]());
+		for (int i = 0; i < INTERNED_STRINGS; i++) {
+			const Atom atom = atoms[i];
+			for (int t = 1; t < INTERN_THREADS; t++) {
+				RUNTIME_TEST_ASSERT(atoms[t * INTERNED_STRINGS + i] == atom);
+			}
+			RUNTIME_TEST_ASSERT(atom != Atom() && atom.Id() <= INTERNED_STRINGS && !usedIds[atom.Id()]);
+			usedIds[atom.Id()] = true;
+			const std::string& str = strings.GetData()[i];
+			RUNTIME_TEST_ASSERT(pool.Hash(atom) == StringView(str.c_str(), str.size()).Hash() && pool.CString(atom)[str.size()] == '\0');
+		}
+		RUNTIME_TEST_ASSERT(pool.Intern("") == Atom() && pool.Count() == INTERNED_STRINGS + 1);
+	}
+	RUNTIME_TEST_SUITE(StringPoolConcurrentInternTests);
+
+	/* Long strings made inside a StringArenaScope take their chars from the arena, and destroying, reassigning or growing them never frees those chars,
+	which would be a bad free under a sanitizer. Strings grown after the scope ends move to the heap, so they outlive the arena's Reset(). */
+	static void StringArenaTests()
+	{
+		const char* longChars = "a long string, well past the small string limit, in an arena";
+		ArenaAllocator arena;
+		String grown;
+		SString sGrown;
+		{
+			StringArenaScope scope(arena);
+			const size_t before = arena.BytesUsed();
+			String small = "short";
+			SString sSmall = "short";
+			RUNTIME_TEST_ASSERT(arena.BytesUsed() == before);
+
+			String first = longChars;
+			const size_t afterFirst = arena.BytesUsed();
+			RUNTIME_TEST_ASSERT(afterFirst > before);
+			{
+				String second = first;
+				SString sSecond = longChars;
+				second = "replaced, and also long enough to need new chars from the arena";
+				sSecond = "replaced, and also long enough to need new chars from the arena";
+				second += first;
+				RUNTIME_TEST_ASSERT(arena.BytesUsed() > afterFirst);
+			}
+			const size_t afterDestroyed = arena.BytesUsed();
+			first = String();
+			RUNTIME_TEST_ASSERT(arena.BytesUsed() == afterDestroyed);
+
+			grown = longChars;
+			sGrown = longChars;
+		}
+
+		// Outside of the scope, growing takes new chars from the heap, and leaves the old ones to the arena.
+		const size_t afterScope = arena.BytesUsed();
+		grown += String(" and grown on the heap");
+		sGrown.Append(" and grown on the heap");
+		String heap = longChars;
+		RUNTIME_TEST_ASSERT(arena.BytesUsed() == afterScope);
+
+		// Reusing the arena overwrites it's old chars, which no string points to anymore.
+		arena.Reset();
+		{
+			StringArenaScope scope(arena);
+			String overwrite(std::string(4000, 'z').c_str());
+			RUNTIME_TEST_ASSERT(arena.BytesUsed() > 0);
+		}
+		const String expected = String::Concat(longChars, " and grown on the heap");
+		RUNTIME_TEST_ASSERT(grown == expected && sGrown.View() == expected.View() && heap == longChars);
+	}
+	RUNTIME_TEST_SUITE(StringArenaTests);
 }
+#endif
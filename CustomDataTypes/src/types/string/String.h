@@ -1,7 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <charconv>
+#include <concepts>
 #include <iostream>
+#include <type_traits>
 #include <types/array/DynamicArray.h>
+#include <types/stats/ContainerStats.h>
+#include <types/string/StringArena.h>
+#include <types/string/StringView.h>
 
 typedef unsigned char uint8;
 typedef unsigned long long uint64;
@@ -9,7 +16,47 @@ typedef unsigned long long uint64;
 #define MAX_SMALL_STRING_LENGTH			31
 #define STRING_FLAG_SMALL_SIZE_BITS 0b00011111
 #define STRING_FLAG_IS_LONG					0b00100000
-#define STRING_FLAG_UNUSED					0b11000000
+#define STRING_FLAG_HASH_CACHED			0b01000000
+#define STRING_FLAG_ARENA						0b10000000
+
+namespace StringInternal
+{
+	/* Piece passed to String::Concat(). Views and chars are referenced, and integers are formatted into the piece itself,
+	so nothing converts to a temporary that the piece would outlive. */
+	struct ConcatPart
+	{
+		const char* data;
+
+		uint64 length;
+
+		char digits[24];
+
+		ConcatPart(StringView part) : data(part.Data()), length(part.Length()) {}
+
+		/* Only exactly char, so other integers are formatted rather than narrowed. The char must outlive the piece. */
+		template<std::same_as<char> C>
+		ConcatPart(const C& part) : data(&part), length(1) {}
+
+		/* Integer formatted in base 10. Bools are "true" or "false". A template, so pointers never convert to bool through it. */
+		template<typename T>
+			requires std::is_integral_v<T> && (!std::is_same_v<T, char>)
+		ConcatPart(T value)
+		{
+			if constexpr (std::is_same_v<T, bool>) {
+				data = value ? "true" : "false";
+				length = value ? 4 : 5;
+			}
+			else {
+				const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+				data = nullptr;
+				length = uint64(result.ptr - digits);
+			}
+		}
+
+		/* Chars of the piece. Formatted integers are read from the piece, so it stays valid when copied. */
+		StringView View() const { return StringView(data ? data : digits, length); }
+	};
+}
 
 /* Dynamically changing string, with small string optimization for strings of length 31 (excluding null terminator).
 Occupies 32 bytes, same as msvc std::string, conviniently is a power of 2 to (hopefully) place multiple strings cleanly in cache lines.
@@ -27,10 +74,11 @@ public:
 			char* data;
 			uint64 length;
 			uint64 capacity;
-			int _padding0;
-			short _padding1;
-			uint8 _padding2;
-			uint8 flags;
+			/* Long strings cache their 56 bit hash across the padding, once STRING_FLAG_HASH_CACHED is set. */
+			mutable int _padding0;
+			mutable short _padding1;
+			mutable uint8 _padding2;
+			mutable uint8 flags;
 		};
 		struct 
 		{
@@ -40,16 +88,19 @@ public:
 
 private:
 
+	/* Allocation and promotion counters. Occupies no space unless CONTAINER_STATS is enabled. */
+	DARRAY_NO_UNIQUE_ADDRESS container_stats_tracker stats;
+
 	/**/
 	inline void SetIsSmallString() 
 	{
-		flags = flags & (STRING_FLAG_UNUSED + STRING_FLAG_SMALL_SIZE_BITS);
+		flags = flags & STRING_FLAG_SMALL_SIZE_BITS;
 	}
 
 	/**/
 	inline void SetIsLongString() 
 	{
-		flags = flags | STRING_FLAG_IS_LONG;
+		flags = (flags | STRING_FLAG_IS_LONG) & ~STRING_FLAG_HASH_CACHED;
 	}
 
 	/* Small string length is stored as an offset from the max length. */
@@ -64,16 +115,80 @@ private:
 		return length;
 	}
 
-	/**/
+	/* Also clears every other flag, since the flags double as the null terminator of a small string of max length. */
 	inline void SetLengthSmall(uint8 SmallLength)
 	{
-		flags = (MAX_SMALL_STRING_LENGTH - SmallLength) + (flags & STRING_FLAG_UNUSED);
+		flags = MAX_SMALL_STRING_LENGTH - SmallLength;
 	}
 
 	/**/
 	inline void SetLengthLong(uint64 LongLength) 
 	{ 
 		length = LongLength;
+		flags = flags & ~STRING_FLAG_HASH_CACHED;
+	}
+
+	/* Whether this is a long string with it's hash cached in the padding.
+	Acquires the padding written by CacheHash(), which const strings may run on another thread. */
+	inline bool IsHashCached() const
+	{
+		const uint8 currentFlags = std::atomic_ref<uint8>(flags).load(std::memory_order_acquire);
+		return (currentFlags & (STRING_FLAG_IS_LONG | STRING_FLAG_HASH_CACHED)) == (STRING_FLAG_IS_LONG | STRING_FLAG_HASH_CACHED);
+	}
+
+	/* Get the hash cached in the padding. Only valid if IsHashCached(). */
+	inline uint64 CachedHash() const
+	{
+		const uint32_t low = uint32_t(std::atomic_ref<int>(_padding0).load(std::memory_order_relaxed));
+		const uint16_t middle = uint16_t(std::atomic_ref<short>(_padding1).load(std::memory_order_relaxed));
+		const uint8 high = std::atomic_ref<uint8>(_padding2).load(std::memory_order_relaxed);
+		return uint64(low) | (uint64(middle) << 32) | (uint64(high) << 48);
+	}
+
+	/* Cache a long string's hash in the padding. Const strings may be hashed by many threads at once, so the padding is written atomically,
+	and the flag is published with release after it. Racing threads write the same hash. */
+	inline void CacheHash(uint64 hash) const
+	{
+		std::atomic_ref<int>(_padding0).store(int(uint32_t(hash)), std::memory_order_relaxed);
+		std::atomic_ref<short>(_padding1).store(short(uint16_t(hash >> 32)), std::memory_order_relaxed);
+		std::atomic_ref<uint8>(_padding2).store(uint8(hash >> 48), std::memory_order_relaxed);
+		std::atomic_ref<uint8>(flags).fetch_or(uint8(STRING_FLAG_HASH_CACHED), std::memory_order_release);
+	}
+
+	/* Whether this long string's chars belong to an arena, and are never freed by the string. See StringArenaScope. */
+	inline bool IsArenaData() const
+	{
+		return flags & STRING_FLAG_ARENA;
+	}
+
+	/**/
+	inline void SetArenaData(bool arena)
+	{
+		flags = arena ? (flags | STRING_FLAG_ARENA) : (flags & ~STRING_FLAG_ARENA);
+	}
+
+	/* Allocate chars for this long string, from the arena of the thread's StringArenaScope if there is one, otherwise the heap.
+	Doesn't free the current chars. Must already be a long string, since the flags share the small string's last char. */
+	inline char* AllocateLongData(uint64 count)
+	{
+		bool arena;
+		char* block = StringArena::AllocateChars(count, arena);
+		SetArenaData(arena);
+		return block;
+	}
+
+	/* Free this long string's chars, unless they belong to an arena. */
+	inline void FreeLongData()
+	{
+		StringArena::FreeChars(data, IsArenaData());
+	}
+
+	/* Copy another long string's cached hash, if it has one. */
+	inline void CopyCachedHash(const String& Other)
+	{
+		if (!IsSmallString() && Other.IsHashCached()) {
+			CacheHash(Other.CachedHash());
+		}
 	}
 
 	/**/
@@ -92,6 +207,12 @@ private:
 	Also forces this string to be considered a long string, regardless of the actual size of the data. */
 	void IncreaseLongStringCapacity(uint64 MinCapacity);
 
+	/* Set the length of an empty small string, allocating exactly the needed capacity if it's long, and write the null terminator.
+	@returns The chars for the caller to fill in. */
+	char* InitializeUninitialized(uint64 NewLength);
+
+	friend class StringBuilder;
+
 public:
 
 	/* Default constructor. Sets string to "". */
@@ -113,11 +234,34 @@ public:
 		}
 		else {
 			capacity = LongStringLength() + 1;
-			data = new char[capacity];
+			data = AllocateLongData(capacity);
 			memcpy(data, _String, LongStringLength() + 1);
+			stats.Allocation();
 		}
+		stats.BytesCopied(Length() + 1);
 	}
 
+	/* Construct from the first length chars of a buffer, which doesn't need to be null terminated. */
+	String(const char* _String, uint64 _Length)
+	{
+		SetLength(_Length);
+		if (IsSmallString()) {
+			memcpy(chars, _String, _Length);
+			chars[_Length] = '\0';
+		}
+		else {
+			capacity = _Length + 1;
+			data = AllocateLongData(capacity);
+			memcpy(data, _String, _Length);
+			data[_Length] = '\0';
+			stats.Allocation();
+		}
+		stats.BytesCopied(_Length + 1);
+	}
+
+	/* Construct with a copy of the chars of a view. */
+	explicit String(StringView view) : String(view.Data(), view.Length()) {}
+
 	/* Copy constructor. Currently duplicates the string data of the other string. */
 	String(const String& Other) 
 	{
@@ -127,18 +271,30 @@ public:
 			//Small = Other.Small;
 		}
 		else {
-			data = new char[LongStringLength() + 1];
+			capacity = LongStringLength() + 1;
+			data = AllocateLongData(capacity);
 			memcpy(data, Other.data, LongStringLength() + 1);
 			//strcpy_s(Long.Data, LongStringLength() + 1, Other.Long.Data);
-			capacity = Other.capacity;
+			CopyCachedHash(Other);
+			stats.Allocation();
 		}
+		stats.BytesCopied(Length() + 1);
 	}
 
-	/* Destructor. If is NOT small string, deletes the char data. */
+	/* Move constructor. Takes the other string's heap data without allocating or copying it. The other string is left as "". */
+	String(String&& Other) noexcept
+	{
+		memcpy(chars, Other.chars, sizeof(chars));
+		Other.chars[0] = '\0';
+		Other.flags = 0;
+		Other.SetLengthSmall(0);
+	}
+
+	/* Destructor. If is NOT small string, deletes the char data, unless it belongs to an arena. */
 	~String() 
 	{
 		if (!IsSmallString()) {
-			delete[] data;
+			FreeLongData();
 		}
 	}
 
@@ -170,6 +326,18 @@ public:
 		}
 	}
 
+	/* Get a view of the whole string. Invalidated by any change to the string. */
+	inline StringView View() const
+	{
+		return StringView(CString(), Length());
+	}
+
+	/* See View(). */
+	inline operator StringView() const
+	{
+		return View();
+	}
+
 	/* Amount of chars this string can hold. */
 	inline uint64 Capacity() const 
 	{
@@ -191,6 +359,27 @@ public:
 	/* Concatenate two strings into a new string. Does not overwrite any of the passed in string data. */
 	static String ConcatenateStrings(const String& str1, const String& str2);
 
+	/* Concatenate any amount of strings, views, c strings, chars and integers into a new string. Integers are formatted in base 10.
+	Measures every piece first, so the result is allocated at most once, unlike chaining operator +. */
+	template<typename... Parts>
+	static String Concat(const Parts&... parts)
+	{
+		const StringInternal::ConcatPart pieces[] = { StringInternal::ConcatPart(parts)..., StringInternal::ConcatPart(StringView()) };
+		uint64 total = 0;
+		for (const StringInternal::ConcatPart& piece : pieces) {
+			total += piece.length;
+		}
+
+		String result;
+		char* out = result.InitializeUninitialized(total);
+		for (const StringInternal::ConcatPart& piece : pieces) {
+			const StringView view = piece.View();
+			memcpy(out, view.Data(), view.Length());
+			out += view.Length();
+		}
+		return result;
+	}
+
 	/* Append the data of another string onto this one. If they two strings reference the same data,
 	it'll simply copy the data, then append. */
 	void AppendString(const String& Other);
@@ -206,21 +395,30 @@ public:
 		return String::ConcatenateStrings(Left, Right);
 	}
 
+	/* Append onto a temporary left string, reusing it's heap capacity instead of allocating a new string. Allows chains such as a + b + c to grow a single buffer. */
+	friend String operator + (String&& Left, const String& Right)
+	{
+		Left.AppendString(Right);
+		return std::move(Left);
+	}
+
 	/* Equivalency. Only checks raw string data. */
 	bool operator == (const char* Str) const {
 		return strcmp(CString(), Str) == 0;
 	}
 
-	/* Equivalency. */
+	/* Equivalency. Long strings that both have their hashes cached reject mismatches on hash before comparing chars. */
 	bool operator == (const String& Other) const {
-		if (Length() != Other.Length()) return false;
-		return strcmp(CString(), Other.CString()) == 0;
+		const uint64 len = Length();
+		if (len != Other.Length()) return false;
+		if (IsHashCached() && Other.IsHashCached() && CachedHash() != Other.CachedHash()) return false;
+		return memcmp(CString(), Other.CString(), len) == 0;
 	}
 
 	/* Set equal to a const char* string. If the string is small enough to be SSO'd, it will be. Copies the data. */
 	void operator = (const char* _String) 
 	{
-		if (!IsSmallString() && data) delete[] data;
+		if (!IsSmallString()) FreeLongData();
 
 		SetLength(strlen(_String));
 		if (IsSmallString()) {
@@ -228,15 +426,17 @@ public:
 		}
 		else {
 			capacity = LongStringLength() + 1;
-			data = new char[capacity];
+			data = AllocateLongData(capacity);
 			memcpy(data, _String, LongStringLength() + 1);
+			stats.Allocation();
 		}
+		stats.BytesCopied(Length() + 1);
 	}
 
 	/* Set equal to another string, copying the data. */
 	void operator = (const String& Other) 
 	{
-		if (!IsSmallString() && data) delete[] data;
+		if (!IsSmallString()) FreeLongData();
 
 		SetLength(Other.Length());
 		if (IsSmallString()) {
@@ -244,11 +444,29 @@ public:
 			//Small = Other.Small;
 		}
 		else {
-			data = new char[LongStringLength() + 1];
+			capacity = LongStringLength() + 1;
+			data = AllocateLongData(capacity);
 			memcpy(data, Other.data, LongStringLength() + 1);
 			//strcpy_s(Long.Data, LongStringLength() + 1, Other.Long.Data);
-			capacity = Other.capacity;
+			CopyCachedHash(Other);
+			stats.Allocation();
 		}
+		stats.BytesCopied(Length() + 1);
+	}
+
+	/* Set equal to another string, taking it's heap data without allocating or copying it. The other string is left as "". */
+	void operator = (String&& Other) noexcept
+	{
+		if (this == &Other) {
+			return;
+		}
+		if (!IsSmallString()) {
+			FreeLongData();
+		}
+		memcpy(chars, Other.chars, sizeof(chars));
+		Other.chars[0] = '\0';
+		Other.flags = 0;
+		Other.SetLengthSmall(0);
 	}
 
 	/* Get a copy of a character at a specific index. */
@@ -266,12 +484,89 @@ public:
 	/* Get a copy of a substring from a boundary.
 	@param start: character index (included).
 	@param end: character index (excluded). */
-	String Substring(uint64 start, uint64 end);
+	String Substring(uint64 start, uint64 end) const;
+
+	/* Get a view of a substring from a boundary, without copying. Invalidated by any change to the string. See StringView::SubstringView(). */
+	StringView SubstringView(uint64 start, uint64 end) const
+	{
+		return View().SubstringView(start, end);
+	}
 	
-	/* Split string into a copy of array of strings given a character splitter. */
-	darray<String> Split(char splitter);
+	/* Split string into a copy of array of strings given a character splitter.
+	Every splitter ends a string, so consecutive splitters produce empty strings. Scans with the SIMD kernels of StringSearch. */
+	darray<String> Split(char splitter) const;
 
-	/* Split string into a copy of array of strings given a string splitter. */
-	darray<String> Split(const String& splitter);
+	/* Split string into a copy of array of strings given a string splitter, in linear time.
+	Every non overlapping splitter ends a string, so consecutive splitters produce empty strings. An empty splitter returns a copy of this string. */
+	darray<String> Split(StringView splitter) const;
+
+	/* Split string into an array of views into this string, without copying any chars. Invalidated by any change to the string. See Split(). */
+	darray<StringView> SplitView(char splitter) const
+	{
+		return View().SplitView(splitter);
+	}
+
+	/* Split string into an array of views into this string, without copying any chars. Invalidated by any change to the string. See Split(). */
+	darray<StringView> SplitView(StringView splitter) const
+	{
+		return View().SplitView(splitter);
+	}
+
+	/* Hash of the string's chars. Equal to the hash of a StringView or SString with the same chars.
+	Long strings compute it once, and cache it until they change. */
+	uint64 Hash() const
+	{
+		if (IsSmallString()) {
+			return View().Hash();
+		}
+		if (!IsHashCached()) {
+			CacheHash(View().Hash());
+		}
+		return CachedHash();
+	}
+
+	/* Find the first occurrence of a substring, using the SIMD kernels of StringSearch. Runs in linear time.
+	@param start (optional): Index to start searching from.
+	@returns Index of the start of the substring, or STRING_NOT_FOUND. An empty substring is found at start. */
+	uint64 Find(StringView substring, uint64 start = 0) const;
+
+	/* Find the first occurrence of a character. See Find(). */
+	uint64 Find(char c, uint64 start = 0) const;
+
+	/* Find the last occurrence of a substring. See Find(). An empty substring is found at Length(). */
+	uint64 FindLast(StringView substring) const;
+
+	/* Find the last occurrence of a character. See Find(). */
+	uint64 FindLast(char c) const;
+
+	/* Check if this string contains a substring. */
+	bool Contains(StringView substring) const { return Find(substring) != STRING_NOT_FOUND; }
+
+	/* Check if this string contains a character. */
+	bool Contains(char c) const { return Find(c) != STRING_NOT_FOUND; }
+
+	/* Count the non overlapping occurrences of a substring. An empty substring is never counted. */
+	uint64 Count(StringView substring) const;
+
+	/* Count the occurrences of a character. */
+	uint64 Count(char c) const;
+
+	/* Get the heap allocations, reallocations, copied bytes and small string promotions of this string.
+	All zeros unless CONTAINER_STATS is enabled. Copies of a string start with their own zeroed stats. */
+	ContainerStats GetStats() const
+	{
+		return stats.Get();
+	}
+
+};
+
+/* Map hasher for String keys. Map<String, V, HashString>
+Takes the key by reference, so a long key stored in the map caches it's own hash, and is never rehashed when the map grows. */
+inline ArrInt HashString(const String& key)
+{
+	return ArrInt(key.Hash());
+}
 
-};
\ No newline at end of file
+/* Strings never point into themselves, so arrays of them grow with a memcpy instead of moving each string. */
+template<>
+struct darray_trivially_relocatable<String> : std::true_type {};
@@ -0,0 +1,19 @@
+#include "StringArena.h"
+
+static thread_local ArenaAllocator* currentArena = nullptr;
+
+StringArenaScope::StringArenaScope(ArenaAllocator& arena)
+{
+	previous = currentArena;
+	currentArena = &arena;
+}
+
+StringArenaScope::~StringArenaScope()
+{
+	currentArena = previous;
+}
+
+ArenaAllocator* StringArenaScope::Current()
+{
+	return currentArena;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <types/allocator/ArenaAllocator.h>
+
+/*
+Routes the long string buffers of String and SString to an arena, for as long as the scope is alive on the constructing thread.
+Strings mark buffers they got from an arena, and never free them, so destroying or reassigning them is free of allocator calls.
+The arena frees them all at once on it's Reset() or destruction, which must only happen once every string using it is destroyed or reassigned.
+Scopes nest, restoring the previous arena on destruction. Each thread has it's own scope, so an arena must only be active on one thread at a time.
+
+	ArenaAllocator requestArena;
+	{
+		StringArenaScope scope(requestArena);
+		String header = String::Concat(method, " ", path); // From requestArena
+	}
+	requestArena.Reset();
+*/
+class StringArenaScope
+{
+private:
+
+	ArenaAllocator* previous;
+
+public:
+
+	/* Make an arena the destination of long string buffers allocated on this thread. */
+	explicit StringArenaScope(ArenaAllocator& arena);
+
+	/* Restore the previously active arena, or the heap if there was none. */
+	~StringArenaScope();
+
+	StringArenaScope(const StringArenaScope&) = delete;
+	void operator = (const StringArenaScope&) = delete;
+
+	/* Get the arena of the innermost scope alive on this thread, or nullptr if there is none. */
+	static ArenaAllocator* Current();
+};
+
+namespace StringArena
+{
+	/* Get chars for a long string buffer, from the current StringArenaScope's arena if there is one, otherwise the heap.
+	@param outArena: Set to whether the chars belong to an arena. */
+	inline char* AllocateChars(size_t count, bool& outArena)
+	{
+		ArenaAllocator* arena = StringArenaScope::Current();
+		outArena = arena != nullptr;
+		if (arena) {
+			return static_cast<char*>(arena->Allocate(count, 1));
+		}
+		return new char[count];
+	}
+
+	/* Free chars from AllocateChars(). Chars belonging to an arena are left for the arena to free. */
+	inline void FreeChars(char* chars, bool arena)
+	{
+		if (!arena) {
+			delete[] chars;
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#include "StringBuilder.h"
+
+void StringBuilder::AppendStored(const char* chars, uint64 count)
+{
+	const uint64 offset = stored.Size();
+	stored.InsertElements(chars, ArrInt(count));
+	pieces.Add(Piece{ nullptr, offset, count });
+	length += count;
+}
+
+StringBuilder& StringBuilder::Append(StringView str)
+{
+	pieces.Add(Piece{ str.Data(), 0, str.Length() });
+	length += str.Length();
+	return *this;
+}
+
+StringBuilder& StringBuilder::AppendCopy(StringView str)
+{
+	AppendStored(str.Data(), str.Length());
+	return *this;
+}
+
+StringBuilder& StringBuilder::Append(char c)
+{
+	AppendStored(&c, 1);
+	return *this;
+}
+
+String StringBuilder::Build() const
+{
+	String result;
+	char* out = result.InitializeUninitialized(length);
+	const char* storedChars = stored.GetData();
+	for (ArrInt i = 0; i < pieces.Size(); i++) {
+		const Piece& piece = pieces.GetData()[i];
+		memcpy(out, piece.external ? piece.external : storedChars + piece.offset, piece.length);
+		out += piece.length;
+	}
+	return result;
+}
+
+void StringBuilder::Clear()
+{
+	pieces.Truncate(0);
+	stored.Truncate(0);
+	length = 0;
+}
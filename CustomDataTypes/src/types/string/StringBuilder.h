@@ -0,0 +1,96 @@
+#pragma once
+
+#include <charconv>
+#include <type_traits>
+#include <types/array/SmallArray.h>
+#include <types/string/SString.h>
+#include <types/string/String.h>
+
+/* Amount of pieces a StringBuilder holds before it's piece list allocates. */
+constexpr size_t STRING_BUILDER_INLINE_PIECES = 24;
+
+/* Amount of copied and formatted chars a StringBuilder holds before it's char buffer allocates. */
+constexpr size_t STRING_BUILDER_INLINE_CHARS = 128;
+
+/*
+Collects pieces of a string, and builds it with a single allocation once the total length is known.
+Appended views are only referenced, not copied, so their chars must stay alive and unchanged until Build().
+Use AppendCopy() for temporaries. Chars, integers and copies are stored within the builder.
+Up to STRING_BUILDER_INLINE_PIECES pieces and STRING_BUILDER_INLINE_CHARS stored chars never touch the heap,
+so building a string from a typical amount of fragments performs exactly one allocation, or none if the result is a small string.
+*/
+class StringBuilder
+{
+private:
+
+	/* A run of chars, either referenced outside the builder, or stored at an offset within it's char buffer. */
+	struct Piece
+	{
+		const char* external;
+		uint64 offset;
+		uint64 length;
+	};
+
+	small_darray<Piece, STRING_BUILDER_INLINE_PIECES> pieces;
+
+	small_darray<char, STRING_BUILDER_INLINE_CHARS> stored;
+
+	uint64 length;
+
+	/* Copy chars into the char buffer, as a new piece. */
+	void AppendStored(const char* chars, uint64 count);
+
+public:
+
+	StringBuilder() : length(0) {}
+
+	/* Append a view of a string, without copying it. See class comment. */
+	StringBuilder& Append(StringView str);
+
+	/* Temporary Strings and SStrings would be destroyed before Build(), so appending a view of one is a compile error. Use AppendCopy(). */
+	template<typename T>
+		requires std::is_same_v<std::remove_const_t<T>, String> || std::is_same_v<std::remove_const_t<T>, SString>
+	StringBuilder& Append(T&& str) = delete;
+
+	/* Append a copy of a string, so it doesn't need to outlive the builder. */
+	StringBuilder& AppendCopy(StringView str);
+
+	/* Append a single char. */
+	StringBuilder& Append(char c);
+
+	/* Append an integer, formatted in base 10. Bools append "true" or "false".
+	A template, so pointers never convert to bool through it. */
+	template<typename T>
+		requires std::is_integral_v<T> && (!std::is_same_v<T, char>)
+	StringBuilder& Append(T value)
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			return Append(value ? StringView("true") : StringView("false"));
+		}
+		else {
+			char buffer[24];
+			const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			AppendStored(buffer, uint64(result.ptr - buffer));
+			return *this;
+		}
+	}
+
+	/* See Append(). */
+	template<typename T>
+	StringBuilder& operator += (T&& value)
+	{
+		return Append(std::forward<T>(value));
+	}
+
+	/* Total length of every piece so far. */
+	uint64 Length() const { return length; }
+
+	/* Amount of pieces appended so far. */
+	ArrInt PieceCount() const { return pieces.Size(); }
+
+	/* Build the string from every piece, allocating exactly it's length + 1 chars if it's a long string. The builder is left unchanged. */
+	String Build() const;
+
+	/* Remove every piece. Keeps any capacity for reuse. */
+	void Clear();
+};
@@ -0,0 +1,115 @@
+#include "StringPool.h"
+
+StringPool::StringPool()
+{
+	table.store(NewTable(STRING_POOL_INITIAL_CAPACITY), std::memory_order_relaxed);
+	Intern(StringView());
+}
+
+StringPool::~StringPool()
+{
+	for (ArrInt i = 0; i < tables.Size(); i++) {
+		delete[] tables[i]->slots;
+		delete tables[i];
+	}
+}
+
+StringPool::Table* StringPool::NewTable(uint64 capacity)
+{
+	Table* newTable = new Table();
+	newTable->mask = capacity - 1;
+	newTable->slots = new std::atomic<uint32_t>[capacity];
+	for (uint64 i = 0; i < capacity; i++) {
+		newTable->slots[i].store(0, std::memory_order_relaxed);
+	}
+	tables.Add(newTable);
+	return newTable;
+}
+
+uint32_t StringPool::Probe(const Table* probeTable, StringView str, uint64 hash) const
+{
+	for (uint64 i = hash & probeTable->mask;; i = (i + 1) & probeTable->mask) {
+		const uint32_t slot = probeTable->slots[i].load(std::memory_order_acquire);
+		if (slot == 0) {
+			return UINT32_MAX;
+		}
+		const Entry& entry = entries[ArrInt(slot - 1)];
+		if (entry.hash == hash && entry.view == str) {
+			return slot - 1;
+		}
+	}
+}
+
+void StringPool::Place(Table* placeTable, uint32_t id, uint64 hash)
+{
+	uint64 i = hash & placeTable->mask;
+	while (placeTable->slots[i].load(std::memory_order_relaxed) != 0) {
+		i = (i + 1) & placeTable->mask;
+	}
+	placeTable->slots[i].store(id + 1, std::memory_order_release);
+}
+
+Atom StringPool::Intern(StringView str)
+{
+	const uint64 hash = str.Hash();
+	uint32_t id = Probe(table.load(std::memory_order_acquire), str, hash);
+	if (id != UINT32_MAX) {
+		return Atom(id);
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	Table* current = table.load(std::memory_order_relaxed);
+	// Another thread may have interned it since the lock free probe.
+	id = Probe(current, str, hash);
+	if (id != UINT32_MAX) {
+		return Atom(id);
+	}
+
+	const uint64 count = entries.Size();
+	if (count >= UINT32_MAX - 1) {
+		_ArrayError("StringPool::Intern() has too many strings for a 32 bit atom.");
+		abort();
+	}
+
+	// Keep the load factor at or below 1/2, so probe sequences stay short.
+	if ((count + 1) * 2 > current->mask + 1) {
+		Table* grown = NewTable((current->mask + 1) * 2);
+		for (uint64 i = 0; i < count; i++) {
+			Place(grown, uint32_t(i), entries[ArrInt(i)].hash);
+		}
+		table.store(grown, std::memory_order_release);
+		current = grown;
+	}
+
+	char* chars = static_cast<char*>(arena.Allocate(str.Length() + 1, 1));
+	memcpy(chars, str.Data(), str.Length());
+	chars[str.Length()] = '\0';
+	id = uint32_t(entries.Add(Entry{ StringView(chars, str.Length()), hash }));
+	Place(current, id, hash);
+	return Atom(id);
+}
+
+bool StringPool::Find(StringView str, Atom& outAtom) const
+{
+	const uint32_t id = Probe(table.load(std::memory_order_acquire), str, str.Hash());
+	if (id == UINT32_MAX) {
+		return false;
+	}
+	outAtom = Atom(id);
+	return true;
+}
+
+StringView StringPool::Get(Atom atom) const
+{
+	return entries[ArrInt(atom.Id())].view;
+}
+
+uint64 StringPool::Hash(Atom atom) const
+{
+	return entries[ArrInt(atom.Id())].hash;
+}
+
+uint64 StringPool::Count() const
+{
+	return entries.Size();
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <types/allocator/ArenaAllocator.h>
+#include <types/array/ConcurrentArray.h>
+#include <types/string/StringView.h>
+
+/* Initial amount of hash table slots of a StringPool. Must be a power of 2. */
+constexpr uint64 STRING_POOL_INITIAL_CAPACITY = 256;
+
+/* Handle to a string interned in a StringPool. Equal atoms from the same pool always have equal strings,
+so comparing two is a single 4 byte compare instead of a strcmp. Default constructed atoms are the empty string. */
+struct Atom
+{
+private:
+
+	uint32_t id;
+
+public:
+
+	constexpr Atom() : id(0) {}
+
+	constexpr explicit Atom(uint32_t _id) : id(_id) {}
+
+	/* Index of the string within it's pool. Unique per string, so it's also a perfect hash within one pool. */
+	constexpr uint32_t Id() const { return id; }
+
+	constexpr bool operator == (const Atom& other) const { return id == other.id; }
+
+	constexpr bool operator != (const Atom& other) const { return id != other.id; }
+};
+
+/* Map hasher for Atom keys. Map<Atom, V, HashAtom> */
+inline ArrInt HashAtom(const Atom& key)
+{
+	return ArrInt(key.Id());
+}
+
+/*
+Thread safe string interning. Each distinct string is copied once into an arena, null terminated, and given an Atom.
+Interned strings and their cached hashes stay valid and never move until the pool is destroyed.
+Lookups probe an open addressing table of atom ids with the strings' cached hashes, and never lock.
+Interning a string that isn't in the pool yet takes a lock. Once a pool is warm, Find() and Intern() of existing strings are lock free.
+*/
+class StringPool
+{
+private:
+
+	struct Entry
+	{
+		StringView view;
+		uint64 hash;
+	};
+
+	/* Open addressing table. Each slot is 0 when empty, or an atom id + 1. Tables are replaced when growing, but kept until destruction
+	so lock free readers still probing an old table stay valid. */
+	struct Table
+	{
+		uint64 mask;
+		std::atomic<uint32_t>* slots;
+	};
+
+	/* Interned strings, indexed by atom id. Never moves elements, so readers can access them while strings are interned. */
+	mutable concurrent_darray<Entry> entries;
+
+	/* Table currently used for lookups. */
+	std::atomic<Table*> table;
+
+	/* Every table ever created, including the current one. Only accessed under the lock. */
+	darray<Table*> tables;
+
+	/* Holds the chars of every interned string. Only accessed under the lock. */
+	ArenaAllocator arena;
+
+	/* Taken to intern new strings. */
+	std::mutex mutex;
+
+	/* Create an empty table, and make it the current one. */
+	Table* NewTable(uint64 capacity);
+
+	/* Probe a table for a string.
+	@returns The atom id, or UINT32_MAX if not found. */
+	uint32_t Probe(const Table* probeTable, StringView str, uint64 hash) const;
+
+	/* Place an atom id into a table that doesn't contain it. */
+	static void Place(Table* placeTable, uint32_t id, uint64 hash);
+
+public:
+
+	/* Construct a pool holding only the empty string, as Atom(). */
+	StringPool();
+
+	/* Frees every interned string. Every atom of this pool is invalidated. */
+	~StringPool();
+
+	StringPool(const StringPool&) = delete;
+	void operator = (const StringPool&) = delete;
+
+	/* Get the atom of a string, interning a copy of it if the pool doesn't have it yet. Safe to call from any amount of threads at once.
+	Lock free if the string is already interned. */
+	Atom Intern(StringView str);
+
+	/* Get the atom of a string without interning it. Lock free. May miss strings being interned by other threads at the same time.
+	@param outAtom: Set to the string's atom if found.
+	@returns If the string is interned. */
+	bool Find(StringView str, Atom& outAtom) const;
+
+	/* Get the interned string of an atom. The view's chars are null terminated, and valid for the lifetime of the pool. */
+	StringView Get(Atom atom) const;
+
+	/* Get the interned string of an atom as a null terminated c string. */
+	const char* CString(Atom atom) const { return Get(atom).Data(); }
+
+	/* Get the cached hash of an atom's string. See StringHash::HashStringBytes(). */
+	uint64 Hash(Atom atom) const;
+
+	/* Amount of interned strings, including the empty string. */
+	uint64 Count() const;
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <types/array/ArraySearch.h>
+#include <types/array/DynamicArray.h>
+
+/*
+Substring search kernels over byte strings, using the same instruction set as ArraySearch.
+Single characters are found with the ArraySearch kernels, scanning a full vector register of bytes per instruction like memchr.
+Longer needles compare a vector of candidate positions against the needle's first and last bytes at once,
+and only fully compare the positions where both match, skipping most of the haystack without touching it byte by byte.
+If too many candidates pass the filter to fully compare (such as with highly repetitive text), the search switches to
+Knuth-Morris-Pratt for the rest of the haystack, so every search runs in linear time.
+Every function returns the haystack length when nothing is found.
+*/
+namespace StringSearch
+{
+	namespace Internal
+	{
+		/* Allowed bytes of full needle comparisons per byte scanned, before switching to the linear time fallback. */
+		constexpr size_t VERIFY_BYTES_PER_SCANNED_BYTE = 4;
+
+		/* Whether candidates so far have been too expensive to verify, compared to the amount of the haystack scanned. */
+		inline bool OverVerifyBudget(size_t verifiedBytes, size_t scannedBytes, size_t needleLength)
+		{
+			return verifiedBytes > VERIFY_BYTES_PER_SCANNED_BYTE * scannedBytes + 4 * needleLength + 64;
+		}
+
+		/* Knuth-Morris-Pratt failure table. Each entry is the length of the longest proper prefix of needle[0..i] that is also a suffix of it. */
+		inline darray<size_t> BuildFailureTable(const char* needle, size_t needleLength)
+		{
+			darray<size_t> table;
+			table.Reserve(ArrInt(needleLength));
+			table.Add(0);
+			size_t matched = 0;
+			for (size_t i = 1; i < needleLength; i++) {
+				while (matched > 0 && needle[i] != needle[matched]) {
+					matched = table[ArrInt(matched - 1)];
+				}
+				if (needle[i] == needle[matched]) {
+					matched++;
+				}
+				table.Add(matched);
+			}
+			return table;
+		}
+
+		/* Linear time search for the first occurrence starting at or after an index, or the last occurrence starting at or before an index.
+		@param findLast: Whether to return the last occurrence starting at or before limit, rather than the first starting at or after start. */
+		inline size_t KmpSearch(const char* haystack, size_t length, const char* needle, size_t needleLength, size_t start, bool findLast, size_t limit)
+		{
+			const darray<size_t> table = BuildFailureTable(needle, needleLength);
+			const size_t* failure = table.GetData();
+			const size_t end = findLast ? (limit + needleLength < length ? limit + needleLength : length) : length;
+			size_t found = length;
+			size_t matched = 0;
+			for (size_t i = start; i < end; i++) {
+				while (matched > 0 && haystack[i] != needle[matched]) {
+					matched = failure[matched - 1];
+				}
+				if (haystack[i] == needle[matched]) {
+					matched++;
+				}
+				if (matched == needleLength) {
+					found = i + 1 - needleLength;
+					if (!findLast) {
+						return found;
+					}
+					matched = failure[matched - 1];
+				}
+			}
+			return found;
+		}
+
+		/* Whether the needle is at a position, given it's first and last bytes already match. */
+		inline bool MatchesInner(const char* candidate, const char* needle, size_t needleLength)
+		{
+			return needleLength <= 2 || memcmp(candidate + 1, needle + 1, needleLength - 2) == 0;
+		}
+	}
+
+	/* Find the first occurrence of a character at or after an index.
+	@returns Index of the character, or length if not found. */
+	inline size_t FindChar(const char* haystack, size_t length, char c, size_t start = 0)
+	{
+		if (start >= length) {
+			return length;
+		}
+		return start + ArraySearch::FindFirst(haystack + start, length - start, c);
+	}
+
+	/* Find the first occurrence of a substring at or after an index.
+	@returns Index of the start of the substring, or length if not found. An empty needle is found at start. */
+	inline size_t Find(const char* haystack, size_t length, const char* needle, size_t needleLength, size_t start = 0)
+	{
+		if (needleLength == 0) {
+			return start <= length ? start : length;
+		}
+		if (start > length || length - start < needleLength) {
+			return length;
+		}
+		if (needleLength == 1) {
+			return FindChar(haystack, length, needle[0], start);
+		}
+
+		using namespace Internal;
+		const size_t lastStart = length - needleLength;
+		size_t verifiedBytes = 0;
+		size_t i = start;
+#ifdef ARRAY_SEARCH_VECTORIZED
+		using namespace ArraySearch::Internal;
+		const Vec firstBytes = Broadcast(needle[0]);
+		const Vec lastBytes = Broadcast(needle[needleLength - 1]);
+		for (; i + VECTOR_BYTES <= lastStart + 1; i += VECTOR_BYTES) {
+			uint32_t mask = CompareBytes<char>(Load(haystack + i), firstBytes) & CompareBytes<char>(Load(haystack + i + needleLength - 1), lastBytes);
+			while (mask) {
+				const size_t candidate = i + std::countr_zero(mask);
+				if (MatchesInner(haystack + candidate, needle, needleLength)) {
+					return candidate;
+				}
+				verifiedBytes += needleLength;
+				mask &= mask - 1;
+			}
+			if (OverVerifyBudget(verifiedBytes, i + VECTOR_BYTES - start, needleLength)) {
+				return KmpSearch(haystack, length, needle, needleLength, i + VECTOR_BYTES, false, 0);
+			}
+		}
+#endif
+		const char first = needle[0];
+		const char last = needle[needleLength - 1];
+		while (i <= lastStart) {
+			const char* candidate = static_cast<const char*>(memchr(haystack + i, first, lastStart + 1 - i));
+			if (candidate == nullptr) {
+				return length;
+			}
+			i = size_t(candidate - haystack);
+			if (candidate[needleLength - 1] == last) {
+				if (MatchesInner(candidate, needle, needleLength)) {
+					return i;
+				}
+				verifiedBytes += needleLength;
+				if (OverVerifyBudget(verifiedBytes, i + 1 - start, needleLength)) {
+					return KmpSearch(haystack, length, needle, needleLength, i + 1, false, 0);
+				}
+			}
+			i++;
+		}
+		return length;
+	}
+
+	/* Find the last occurrence of a substring.
+	@returns Index of the start of the substring, or length if not found. An empty needle is found at length. */
+	inline size_t FindLast(const char* haystack, size_t length, const char* needle, size_t needleLength)
+	{
+		if (needleLength == 0 || length < needleLength) {
+			return length;
+		}
+		if (needleLength == 1) {
+			return ArraySearch::FindLast(haystack, length, needle[0]);
+		}
+
+		using namespace Internal;
+		// Every start position after end has been checked.
+		size_t end = length - needleLength + 1;
+		size_t verifiedBytes = 0;
+#ifdef ARRAY_SEARCH_VECTORIZED
+		using namespace ArraySearch::Internal;
+		const Vec firstBytes = Broadcast(needle[0]);
+		const Vec lastBytes = Broadcast(needle[needleLength - 1]);
+		while (end >= VECTOR_BYTES) {
+			const size_t block = end - VECTOR_BYTES;
+			uint32_t mask = CompareBytes<char>(Load(haystack + block), firstBytes) & CompareBytes<char>(Load(haystack + block + needleLength - 1), lastBytes);
+			while (mask) {
+				const size_t offset = 31 - std::countl_zero(mask);
+				if (MatchesInner(haystack + block + offset, needle, needleLength)) {
+					return block + offset;
+				}
+				verifiedBytes += needleLength;
+				mask &= ~(uint32_t(1) << offset);
+			}
+			end = block;
+			if (OverVerifyBudget(verifiedBytes, length - needleLength + 1 - end, needleLength)) {
+				return end == 0 ? length : KmpSearch(haystack, length, needle, needleLength, 0, true, end - 1);
+			}
+		}
+#endif
+		const char first = needle[0];
+		const char last = needle[needleLength - 1];
+		while (end > 0) {
+			end--;
+			if (haystack[end] == first && haystack[end + needleLength - 1] == last) {
+				if (MatchesInner(haystack + end, needle, needleLength)) {
+					return end;
+				}
+				verifiedBytes += needleLength;
+				if (end > 0 && OverVerifyBudget(verifiedBytes, length - needleLength + 1 - end, needleLength)) {
+					return KmpSearch(haystack, length, needle, needleLength, 0, true, end - 1);
+				}
+			}
+		}
+		return length;
+	}
+
+	/* Call a function with the index of every non overlapping occurrence of a substring, in ascending order.
+	@param func: Callable taking a size_t index. */
+	template<typename Func>
+	void ForEachMatch(const char* haystack, size_t length, const char* needle, size_t needleLength, Func&& func)
+	{
+		if (needleLength == 0) {
+			return;
+		}
+		if (needleLength == 1) {
+			ArraySearch::ForEachMatch(haystack, length, needle[0], func);
+			return;
+		}
+		size_t i = Find(haystack, length, needle, needleLength, 0);
+		while (i != length) {
+			func(i);
+			i = Find(haystack, length, needle, needleLength, i + needleLength);
+		}
+	}
+
+	/* Count the non overlapping occurrences of a substring. */
+	inline size_t Count(const char* haystack, size_t length, const char* needle, size_t needleLength)
+	{
+		if (needleLength == 1) {
+			return ArraySearch::Count(haystack, length, needle[0]);
+		}
+		size_t total = 0;
+		ForEachMatch(haystack, length, needle, needleLength, [&total](size_t) { total++; });
+		return total;
+	}
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <types/array/DynamicArray.h>
+#include <types/string/StringSearch.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+typedef unsigned long long uint64;
+
+/* Returned by searches that find nothing. */
+constexpr uint64 STRING_NOT_FOUND = ~0ULL;
+
+namespace StringHash
+{
+	namespace Internal
+	{
+		constexpr uint64 SECRET0 = 0xa0761d6478bd642fULL;
+		constexpr uint64 SECRET1 = 0xe7037ed1a0b428dbULL;
+		constexpr uint64 SECRET2 = 0x8ebc6af09c88c6e3ULL;
+
+		/* Multiply into 128 bits, and fold the high half into the low half. */
+		inline uint64 Mix(uint64 a, uint64 b)
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			uint64 high;
+			const uint64 low = _umul128(a, b, &high);
+			return low ^ high;
+#elif defined(__SIZEOF_INT128__)
+			const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+			return uint64(product) ^ uint64(product >> 64);
+#else
+			const uint64 aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+			const uint64 bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+			const uint64 lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+			const uint64 middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFF) + (highLow & 0xFFFFFFFF);
+			const uint64 low = (lowLow & 0xFFFFFFFF) | (middle << 32);
+			const uint64 high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+			return low ^ high;
+#endif
+		}
+
+		inline uint64 Read64(const char* bytes)
+		{
+			uint64 v;
+			memcpy(&v, bytes, 8);
+			return v;
+		}
+
+		/* Read 1 to 7 bytes without reading past them. */
+		inline uint64 ReadTail(const char* bytes, uint64 count)
+		{
+			uint64 v = 0;
+			memcpy(&v, bytes, count);
+			return v;
+		}
+	}
+
+	/* Hash a run of bytes, consuming 16 bytes per 128 bit multiply. (Based on wyhash)
+	@returns 56 bit hash, in the low bits. Equal bytes always give equal hashes. 56 bits fit in the spare bytes of a long String, which caches it's hash. */
+	inline uint64 HashStringBytes(const char* data, uint64 length)
+	{
+		using namespace Internal;
+		uint64 hash = SECRET0 ^ Mix(length ^ SECRET1, SECRET2);
+		uint64 i = 0;
+		for (; i + 16 <= length; i += 16) {
+			hash = Mix(Read64(data + i) ^ SECRET1, Read64(data + i + 8) ^ hash);
+		}
+		if (length - i >= 8) {
+			hash = Mix(Read64(data + i) ^ SECRET1, hash ^ SECRET2);
+			i += 8;
+		}
+		if (length - i > 0) {
+			hash = Mix(ReadTail(data + i, length - i) ^ SECRET2, hash ^ SECRET1);
+		}
+		return Mix(hash ^ SECRET0, length ^ SECRET2) >> 8;
+	}
+}
+
+/* Non owning view of a run of chars, as a pointer and length. Never allocates, and isn't null terminated in general.
+String, SString and const char* all implicitly convert to it, so it's the parameter type for read only string arguments.
+The viewed chars must outlive the view. */
+struct StringView
+{
+private:
+
+	const char* data;
+
+	uint64 length;
+
+public:
+
+	/* Empty view. */
+	constexpr StringView() : data(""), length(0) {}
+
+	/* View a null terminated string, excluding the null terminator. */
+	constexpr StringView(const char* _String) : data(_String), length(std::char_traits<char>::length(_String)) {}
+
+	/* View the first length chars of a buffer. */
+	constexpr StringView(const char* _String, uint64 _Length) : data(_String), length(_Length) {}
+
+	/* Pointer to the first viewed char. Not null terminated in general. */
+	constexpr const char* Data() const { return data; }
+
+	constexpr uint64 Length() const { return length; }
+
+	constexpr bool IsEmpty() const { return length == 0; }
+
+	/* Get a copy of the character at a specific index. Returns '\0' if out of bounds. */
+	constexpr char operator [] (uint64 index) const
+	{
+		return index < length ? data[index] : '\0';
+	}
+
+	constexpr const char* begin() const { return data; }
+
+	constexpr const char* end() const { return data + length; }
+
+	/* Get a view of a substring from a boundary, without copying.
+	@param start: character index (included).
+	@param end: character index (excluded). Clamped to the length.
+	@returns The substring view, or an empty view if start is past end. */
+	constexpr StringView SubstringView(uint64 start, uint64 end) const
+	{
+		if (end > length) {
+			end = length;
+		}
+		if (start >= end) {
+			return StringView();
+		}
+		return StringView(data + start, end - start);
+	}
+
+	/* Find the first occurrence of a substring. See String::Find(). */
+	uint64 Find(StringView substring, uint64 start = 0) const
+	{
+		const uint64 index = StringSearch::Find(data, length, substring.data, substring.length, start);
+		return index == length && (substring.length > 0 || start > length) ? STRING_NOT_FOUND : index;
+	}
+
+	/* Find the first occurrence of a character. See String::Find(). */
+	uint64 Find(char c, uint64 start = 0) const
+	{
+		const uint64 index = StringSearch::FindChar(data, length, c, start);
+		return index == length ? STRING_NOT_FOUND : index;
+	}
+
+	/* Find the last occurrence of a substring. See String::FindLast(). */
+	uint64 FindLast(StringView substring) const
+	{
+		const uint64 index = StringSearch::FindLast(data, length, substring.data, substring.length);
+		return index == length && substring.length > 0 ? STRING_NOT_FOUND : index;
+	}
+
+	/* Find the last occurrence of a character. See String::FindLast(). */
+	uint64 FindLast(char c) const
+	{
+		const uint64 index = ArraySearch::FindLast(data, length, c);
+		return index == length ? STRING_NOT_FOUND : index;
+	}
+
+	bool Contains(StringView substring) const { return Find(substring) != STRING_NOT_FOUND; }
+
+	bool Contains(char c) const { return Find(c) != STRING_NOT_FOUND; }
+
+	/* Count the non overlapping occurrences of a substring. An empty substring is never counted. */
+	uint64 Count(StringView substring) const
+	{
+		return StringSearch::Count(data, length, substring.data, substring.length);
+	}
+
+	uint64 Count(char c) const
+	{
+		return ArraySearch::Count(data, length, c);
+	}
+
+	/* Call a function with a view of every piece between splitters, without allocating.
+	Same pieces as String::Split().
+	@param func: Callable taking a StringView. */
+	template<typename Func>
+	void ForEachSplit(char splitter, Func&& func) const
+	{
+		uint64 first = 0;
+		ArraySearch::ForEachMatch(data, length, splitter, [&](size_t i) {
+			func(StringView(data + first, i - first));
+			first = i + 1;
+		});
+		func(StringView(data + first, length - first));
+	}
+
+	/* Call a function with a view of every piece between non overlapping splitters, without allocating. Runs in linear time.
+	Same pieces as String::Split().
+	@param func: Callable taking a StringView. */
+	template<typename Func>
+	void ForEachSplit(StringView splitter, Func&& func) const
+	{
+		uint64 first = 0;
+		StringSearch::ForEachMatch(data, length, splitter.data, splitter.length, [&](size_t i) {
+			func(StringView(data + first, i - first));
+			first = i + splitter.length;
+		});
+		func(StringView(data + first, length - first));
+	}
+
+	/* Split into an array of views into this view's chars. Only allocates the array. See ForEachSplit(). */
+	darray<StringView> SplitView(char splitter) const
+	{
+		darray<StringView> arr;
+		ForEachSplit(splitter, [&arr](StringView piece) { arr.Add(piece); });
+		return arr;
+	}
+
+	/* Split into an array of views into this view's chars. Only allocates the array. See ForEachSplit(). */
+	darray<StringView> SplitView(StringView splitter) const
+	{
+		darray<StringView> arr;
+		ForEachSplit(splitter, [&arr](StringView piece) { arr.Add(piece); });
+		return arr;
+	}
+
+	/* Hash of the viewed chars. Equal to the hash of any String or SString with the same chars. See StringHash::HashStringBytes(). */
+	uint64 Hash() const
+	{
+		return StringHash::HashStringBytes(data, length);
+	}
+
+	/* Lexicographic byte comparison.
+	@returns Negative if this view sorts first, positive if other sorts first, or 0 if equal. */
+	int Compare(StringView other) const
+	{
+		const uint64 shortest = length < other.length ? length : other.length;
+		const int result = shortest == 0 ? 0 : memcmp(data, other.data, shortest);
+		if (result != 0) {
+			return result;
+		}
+		return length < other.length ? -1 : (length > other.length ? 1 : 0);
+	}
+
+	/* Equivalency. Compares lengths before bytes. */
+	friend bool operator == (StringView left, StringView right)
+	{
+		return left.length == right.length && (left.length == 0 || memcmp(left.data, right.data, left.length) == 0);
+	}
+
+	friend bool operator != (StringView left, StringView right) { return !(left == right); }
+
+	friend bool operator < (StringView left, StringView right) { return left.Compare(right) < 0; }
+
+	friend bool operator > (StringView left, StringView right) { return left.Compare(right) > 0; }
+
+	friend bool operator <= (StringView left, StringView right) { return left.Compare(right) <= 0; }
+
+	friend bool operator >= (StringView left, StringView right) { return left.Compare(right) >= 0; }
+
+	/* std::cout << StringView */
+	friend std::ostream& operator << (std::ostream& os, StringView view)
+	{
+		os.write(view.data, std::streamsize(view.length));
+		return os;
+	}
+};
+
+/* Map hasher for StringView keys. Map<StringView, V, HashStringView> */
+inline ArrInt HashStringView(const StringView& key)
+{
+	return ArrInt(key.Hash());
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <types/array/DynamicArray.h>
+
+#define _pragmsg(s) _Pragma(#s)
+#define PRAGMA_MESSAGE(msg) _pragmsg(message(#msg))
+
+/* Compile time unit test of a constexpr expression. Fails the build if false. */
+#define TEST_ASSERT(test) \
+PRAGMA_MESSAGE([RUN UNIT TEST]:  test);	\
+static_assert(test, "[Array Compile Unit Test]: " #test)
+
+#define RUN_UNIT_TESTS_AT_COMPILE
+
+/* Runtime unit tests, for code that can't run at compile time such as heap allocators, SIMD kernels and threads.
+Suites only register themselves during static initialization, and never run until RunRuntimeUnitTests() is called, such as from main(),
+so programs using the library never spawn test threads or abort during startup. Compiled in unless NDEBUG is defined.
+Override by defining RUNTIME_UNIT_TESTS as true or false. */
+#ifndef RUNTIME_UNIT_TESTS
+#ifdef NDEBUG
+#define RUNTIME_UNIT_TESTS false
+#else
+#define RUNTIME_UNIT_TESTS true
+#endif
+#endif
+
+namespace UnitTest
+{
+	typedef void (*RuntimeSuite)();
+
+	struct RuntimeSuiteEntry
+	{
+		const char* name;
+		RuntimeSuite suite;
+	};
+
+	/* Every registered suite. Created on first use, so registering from any translation unit's static initialization is safe. */
+	inline darray<RuntimeSuiteEntry>& RuntimeSuites()
+	{
+		static darray<RuntimeSuiteEntry> suites;
+		return suites;
+	}
+
+	/* Add a suite to be run by RunRuntimeUnitTests(). */
+	inline bool RegisterRuntimeSuite(const char* name, RuntimeSuite suite)
+	{
+		RuntimeSuites().Add({ name, suite });
+		return true;
+	}
+
+	/* Run every registered suite, in registration order. Aborts on the first failed check.
+	@returns The amount of suites run. */
+	inline ArrInt RunRuntimeUnitTests()
+	{
+		darray<RuntimeSuiteEntry>& suites = RuntimeSuites();
+		for (ArrInt i = 0; i < suites.Size(); i++) {
+			std::cout << "[RUN RUNTIME UNIT TEST]: " << suites[i].name << '\n';
+			suites[i].suite();
+		}
+		return suites.Size();
+	}
+}
+
+/* Check a condition within a runtime unit test suite. Displays the condition and aborts if false, flushing first so the message survives redirected output. */
+#define RUNTIME_TEST_ASSERT(test) \
+if (!(test)) { _ArrayError("[Runtime Unit Test]: " #test); std::cout.flush(); abort(); }
+
+/* Register a void function of RUNTIME_TEST_ASSERT checks, to be run by UnitTest::RunRuntimeUnitTests(). */
+#define RUNTIME_TEST_SUITE(suite) \
+static const bool suite##Registered = UnitTest::RegisterRuntimeSuite(#suite, suite)
@@ -0,0 +1,191 @@
+#include "ThreadPool.h"
+#include <memory>
+#include <numeric>
+#include <types/algorithm/ParallelAlgorithms.h>
+#include <types/test/UnitTest.h>
+
+/* Set on worker threads, and on a calling thread while it runs chunks, so nested ParallelFor() calls run serially instead of waiting on their own pool. */
+static thread_local bool isInsideParallelFor = false;
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+	batch = nullptr;
+	generation = 0;
+	busyWorkers = 0;
+	stopping = false;
+
+	workers.Reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; i++) {
+		workers.Add(std::thread(&ThreadPool::WorkerLoop, this));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	for (ArrInt i = 0; i < workers.Size(); i++) {
+		workers[i].join();
+	}
+}
+
+ThreadPool& ThreadPool::Global()
+{
+	static ThreadPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+	return pool;
+}
+
+void ThreadPool::WorkerLoop()
+{
+	isInsideParallelFor = true;
+	unsigned long long seenGeneration = 0;
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		workAvailable.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+		if (stopping) {
+			return;
+		}
+
+		seenGeneration = generation;
+		Batch* current = batch;
+		if (current == nullptr) {
+			continue;
+		}
+
+		busyWorkers++;
+		lock.unlock();
+		RunChunks(current);
+		lock.lock();
+		busyWorkers--;
+		if (busyWorkers == 0) {
+			workDone.notify_all();
+		}
+	}
+}
+
+void ThreadPool::RunChunks(Batch* batch)
+{
+	while (true) {
+		const size_t begin = batch->nextBegin.fetch_add(batch->grainSize, std::memory_order_relaxed);
+		if (begin >= batch->count) {
+			return;
+		}
+		const size_t end = begin + batch->grainSize < batch->count ? begin + batch->grainSize : batch->count;
+		batch->func(batch->context, begin, end);
+	}
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, RangeFunc func, void* context)
+{
+	if (grainSize == 0) {
+		grainSize = 1;
+	}
+	if (count <= grainSize || workers.Size() == 0 || isInsideParallelFor) {
+		// Same chunks as the parallel path, so callers can rely on begin / grainSize being a chunk index.
+		for (size_t begin = 0; begin < count; begin += grainSize) {
+			func(context, begin, begin + grainSize < count ? begin + grainSize : count);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> submitLock(submitMutex);
+
+	Batch work;
+	work.func = func;
+	work.context = context;
+	work.count = count;
+	work.grainSize = grainSize;
+	work.nextBegin.store(0, std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		batch = &work;
+		generation++;
+	}
+	workAvailable.notify_all();
+
+	isInsideParallelFor = true;
+	RunChunks(&work);
+	isInsideParallelFor = false;
+
+	// Every chunk has been claimed. Wait for the workers still running theirs, then retire the batch.
+	std::unique_lock<std::mutex> lock(mutex);
+	workDone.wait(lock, [&]() { return busyWorkers == 0; });
+	batch = nullptr;
+}
+
+#if RUNTIME_UNIT_TESTS == true
+namespace ThreadPoolRuntimeUnitTests
+{
+	/* Pseudo random values with plenty of duplicates, so stability is observable. */
+	static darray<int> RandomValues(size_t count)
+	{
+		darray<int> arr;
+		unsigned int state = 12345;
+		for (size_t i = 0; i < count; i++) {
+			state = state * 1103515245 + 12345;
+			arr.Add(int((state >> 16) % 1000));
+		}
+		return arr;
+	}
+
+	/* Every index is visited exactly once, in chunks starting at multiples of the grain size. */
+	static void ParallelForTests()
+	{
+		ThreadPool pool(3);
+		RUNTIME_TEST_ASSERT(pool.ThreadCount() == 4);
+		for (size_t count : { size_t(0), size_t(1), size_t(63), size_t(64), size_t(1000) }) {
+			std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[count]());
+			std::atomic<bool> misaligned = false;
+			pool.ParallelFor(count, 64, [&](size_t begin, size_t end) {
+				if (begin % 64 != 0 || end > count || end - begin > 64) {
+					misaligned = true;
+				}
+				for (size_t i = begin; i < end; i++) {
+					visits[i]++;
+				}
+			});
+			RUNTIME_TEST_ASSERT(!misaligned);
+			for (size_t i = 0; i < count; i++) {
+				RUNTIME_TEST_ASSERT(visits[i] == 1);
+			}
+		}
+	}
+	RUNTIME_TEST_SUITE(ParallelForTests);
+
+	/* Sort, reduce and partition match their serial std equivalents, both across threads and on a single thread. */
+	static void ParallelAlgorithmTests()
+	{
+		ThreadPool threaded(3);
+		ThreadPool single(0);
+		for (ThreadPool* pool : { &threaded, &single }) {
+			for (size_t count : { size_t(0), size_t(1), size_t(100), size_t(5000) }) {
+				const darray<int> values = RandomValues(count);
+
+				// Sort by value / 10, so equal keys keep their original order only if the sort is stable.
+				auto byTens = [](int a, int b) { return a / 10 < b / 10; };
+				darray<int> sorted = values;
+				ParallelSort(sorted, byTens, 64, *pool);
+				darray<int> expectedSorted = values;
+				std::stable_sort(expectedSorted.GetData(), expectedSorted.GetData() + count, byTens);
+				RUNTIME_TEST_ASSERT(std::equal(sorted.GetData(), sorted.GetData() + count, expectedSorted.GetData()));
+
+				const int sum = ParallelReduce(values.GetData(), count, 0, std::plus<>(), 64, *pool);
+				RUNTIME_TEST_ASSERT(sum == std::accumulate(values.GetData(), values.GetData() + count, 0));
+
+				auto isEven = [](const int& value) { return value % 2 == 0; };
+				darray<int> partitioned = values;
+				const size_t evens = ParallelPartition(partitioned, isEven, 64, *pool);
+				darray<int> expectedPartitioned = values;
+				const int* expectedEnd = std::stable_partition(expectedPartitioned.GetData(), expectedPartitioned.GetData() + count, isEven);
+				RUNTIME_TEST_ASSERT(evens == size_t(expectedEnd - expectedPartitioned.GetData()));
+				RUNTIME_TEST_ASSERT(std::equal(partitioned.GetData(), partitioned.GetData() + count, expectedPartitioned.GetData()));
+			}
+		}
+	}
+	RUNTIME_TEST_SUITE(ParallelAlgorithmTests);
+}
+#endif
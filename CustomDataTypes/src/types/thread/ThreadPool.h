@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <types/array/DynamicArray.h>
+
+/*
+Fixed set of worker threads that split index ranges between themselves and the calling thread.
+Only one ParallelFor() runs on a pool at a time. Calls from other threads wait their turn,
+and calls from within a running chunk (nested parallelism) run serially on that thread.
+*/
+class ThreadPool
+{
+public:
+
+	/* Function called with a half open range of indices [begin, end). */
+	typedef void (*RangeFunc)(void* context, size_t begin, size_t end);
+
+private:
+
+	/* A single ParallelFor() call, shared by all threads working on it. */
+	struct Batch
+	{
+		RangeFunc func;
+		void* context;
+		size_t count;
+		size_t grainSize;
+		std::atomic<size_t> nextBegin;
+	};
+
+	darray<std::thread> workers;
+
+	/* Guards batch, generation, busyWorkers and stopping. */
+	std::mutex mutex;
+
+	/* Only one batch runs at a time. */
+	std::mutex submitMutex;
+
+	std::condition_variable workAvailable;
+
+	std::condition_variable workDone;
+
+	Batch* batch;
+
+	/* Incremented on every new batch, so sleeping workers know there is new work. */
+	unsigned long long generation;
+
+	/* Amount of workers currently running the batch. */
+	unsigned int busyWorkers;
+
+	bool stopping;
+
+	void WorkerLoop();
+
+	/* Claim and run chunks of a batch until none are left. */
+	static void RunChunks(Batch* batch);
+
+public:
+
+	/* @param threadCount: Amount of worker threads. The calling thread of ParallelFor() also does work,
+	so a pool with threadCount workers uses threadCount + 1 threads. */
+	ThreadPool(unsigned int threadCount);
+
+	/* Stops and joins all workers. */
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	void operator = (const ThreadPool&) = delete;
+
+	/* Shared pool with one worker per hardware thread, minus the calling thread. Created on first use. */
+	static ThreadPool& Global();
+
+	/* Amount of threads that run work, including the calling thread. */
+	size_t ThreadCount() const { return workers.Size() + 1; }
+
+	/* Split [0, count) into chunks of grainSize indices, and run func on each chunk across the pool. Returns once every chunk is done.
+	Chunks always start at a multiple of grainSize, even when run serially on the calling thread (if count is no larger than grainSize). */
+	void ParallelFor(size_t count, size_t grainSize, RangeFunc func, void* context);
+
+	/* See ParallelFor(size_t, size_t, RangeFunc, void*).
+	@param func: Callable taking (size_t begin, size_t end). */
+	template<typename Func>
+	void ParallelFor(size_t count, size_t grainSize, Func&& func)
+	{
+		ParallelFor(count, grainSize, [](void* context, size_t begin, size_t end) {
+			(*static_cast<std::remove_reference_t<Func>*>(context))(begin, end);
+		}, (void*)&func);
+	}
+};